@@ -0,0 +1,279 @@
+#include <harness/benchmarkHarness.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+#ifndef RACING_GIT_REVISION
+#define RACING_GIT_REVISION "unknown"
+#endif
+
+namespace
+{
+    double Percentile(const std::vector<double>& sortedSamples, double p)
+    {
+        // Linear interpolation between closest ranks
+        double rank = p * (sortedSamples.size() - 1);
+        size_t lower = static_cast<size_t>(std::floor(rank));
+        size_t upper = std::min(lower + 1, sortedSamples.size() - 1);
+        double fraction = rank - lower;
+        return sortedSamples[lower] + fraction * (sortedSamples[upper] - sortedSamples[lower]);
+    }
+
+    std::string EscapeJson(const std::string& str)
+    {
+        std::string result;
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result;
+    }
+
+    // Read back the lines written by WriteJson: name -> median
+    bool ReadMedians(const std::string& path, std::map<std::string, double>& medians)
+    {
+        std::ifstream file(path);
+        if (!file)
+            return false;
+
+        const std::string nameKey = "\"name\": \"";
+        const std::string medianKey = "\"median_ns\": ";
+        std::string line;
+        while (std::getline(file, line))
+        {
+            size_t namePos = line.find(nameKey);
+            size_t medianPos = line.find(medianKey);
+            if (namePos == std::string::npos || medianPos == std::string::npos)
+                continue;
+
+            namePos += nameKey.size();
+            size_t nameEnd = line.find('"', namePos);
+            if (nameEnd == std::string::npos)
+                continue;
+            medians[line.substr(namePos, nameEnd - namePos)] = std::atof(line.c_str() + medianPos + medianKey.size());
+        }
+        return true;
+    }
+
+    std::string FormatTime(double ns)
+    {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(2);
+        if (ns < 1e3)
+            stream << ns << "ns";
+        else if (ns < 1e6)
+            stream << ns / 1e3 << "us";
+        else
+            stream << ns / 1e6 << "ms";
+        return stream.str();
+    }
+}
+
+bool BenchmarkHarness::ParseArguments(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--filter") == 0 && hasValue)
+            options.filter = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 && hasValue)
+            options.jsonPath = argv[++i];
+        else if (strcmp(argv[i], "--compare") == 0 && hasValue)
+            options.comparePath = argv[++i];
+        else if (strcmp(argv[i], "--min-time") == 0 && hasValue)
+            options.minTimeS = std::atof(argv[++i]);
+        else if (strcmp(argv[i], "--min-samples") == 0 && hasValue)
+            options.minSamples = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--max-samples") == 0 && hasValue)
+            options.maxSamples = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else
+            return false;
+    }
+    options.minSamples = std::max(options.minSamples, 1u);
+    options.maxSamples = std::max(options.maxSamples, options.minSamples);
+    return true;
+}
+
+void BenchmarkHarness::PrintUsage(const char* executable)
+{
+    std::cout << "Usage: " << executable << " [--filter <substring>] [--json <output.json>] [--compare <baseline.json>]" << std::endl;
+    std::cout << "       [--min-time <seconds>] [--min-samples <n>] [--max-samples <n>]" << std::endl;
+}
+
+bool BenchmarkHarness::IsEnabled(const std::string& name) const
+{
+    return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+}
+
+void BenchmarkHarness::Run(const std::string& name, const Function& setup, const Function& body, unsigned int nbIterations, unsigned int nbItems)
+{
+    if (!IsEnabled(name))
+        return;
+
+    nbIterations = std::max(nbIterations, 1u);
+    auto runSample = [&setup, &body, nbIterations]()
+    {
+        if (setup)
+            setup();
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < nbIterations; ++i)
+            body();
+        auto duration = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(duration).count() / nbIterations;
+    };
+
+    for (unsigned int i = 0; i < m_options.warmupSamples; ++i)
+        runSample();
+
+    std::vector<double> samples;
+    samples.reserve(m_options.minSamples);
+    double totalTimeNs = 0.0;
+    const double minTimeNs = m_options.minTimeS * 1e9;
+    while (samples.size() < m_options.maxSamples && (samples.size() < m_options.minSamples || totalTimeNs < minTimeNs))
+    {
+        samples.push_back(runSample());
+        totalTimeNs += samples.back() * nbIterations;
+    }
+
+    m_results.push_back(ComputeStatistics(name, samples, nbItems));
+    const Result& result = m_results.back();
+    std::cout << std::left << std::setw(48) << name << " median " << std::setw(10) << FormatTime(result.median)
+              << " p90 " << std::setw(10) << FormatTime(result.p90) << " p99 " << std::setw(10) << FormatTime(result.p99)
+              << " MAD " << std::setw(10) << FormatTime(result.mad) << " (" << result.nbSamples << " samples)" << std::endl;
+}
+
+BenchmarkHarness::Result BenchmarkHarness::ComputeStatistics(const std::string& name, std::vector<double>& samples, unsigned int nbItems)
+{
+    Result result;
+    result.name = name;
+    result.nbItems = nbItems;
+    result.nbSamples = samples.size();
+    if (samples.empty())
+        return result;
+
+    std::sort(samples.begin(), samples.end());
+    result.min = samples.front();
+    result.max = samples.back();
+    result.median = Percentile(samples, 0.5);
+    result.p90 = Percentile(samples, 0.9);
+    result.p99 = Percentile(samples, 0.99);
+    result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+
+    std::vector<double> deviations(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i)
+        deviations[i] = std::abs(samples[i] - result.median);
+    std::sort(deviations.begin(), deviations.end());
+    result.mad = Percentile(deviations, 0.5);
+    return result;
+}
+
+void BenchmarkHarness::PrintSummary(std::ostream& stream) const
+{
+    stream << std::endl << std::left << std::setw(48) << "Benchmark" << std::setw(12) << "median" << std::setw(12) << "per item"
+           << std::setw(12) << "p99" << std::setw(12) << "MAD %" << std::endl;
+    for (const Result& result : m_results)
+    {
+        double madPercent = result.median > 0.0 ? 100.0 * result.mad / result.median : 0.0;
+        std::ostringstream mad;
+        mad << std::fixed << std::setprecision(1) << madPercent;
+        stream << std::left << std::setw(48) << result.name << std::setw(12) << FormatTime(result.median)
+               << std::setw(12) << FormatTime(result.median / result.nbItems) << std::setw(12) << FormatTime(result.p99)
+               << std::setw(12) << mad.str() << std::endl;
+    }
+}
+
+int BenchmarkHarness::Finish() const
+{
+    PrintSummary(std::cout);
+
+    int errorCode = 0;
+    if (!m_options.jsonPath.empty())
+        errorCode = WriteJson(m_options.jsonPath);
+    if (!m_options.comparePath.empty() && errorCode == 0)
+        errorCode = Compare(m_options.comparePath, std::cout);
+    return errorCode;
+}
+
+int BenchmarkHarness::WriteJson(const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        std::cerr << "Failed to open " << path << std::endl;
+        return -1;
+    }
+
+    std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    file << std::setprecision(10);
+    file << "{" << std::endl;
+    file << "\"context\": {\"date\": \"" << date << "\", \"revision\": \"" << RACING_GIT_REVISION << "\"";
+#ifdef __VERSION__
+    file << ", \"compiler\": \"" << EscapeJson(__VERSION__) << "\"";
+#endif
+#ifdef NDEBUG
+    file << ", \"assertions\": false";
+#else
+    file << ", \"assertions\": true";
+#endif
+    file << "}," << std::endl;
+    file << "\"benchmarks\": [" << std::endl;
+    for (size_t i = 0; i < m_results.size(); ++i)
+    {
+        const Result& result = m_results[i];
+        // One benchmark per line, Compare relies on it
+        file << "{\"name\": \"" << EscapeJson(result.name) << "\", \"items\": " << result.nbItems
+             << ", \"samples\": " << result.nbSamples << ", \"median_ns\": " << result.median
+             << ", \"mean_ns\": " << result.mean << ", \"min_ns\": " << result.min << ", \"p90_ns\": " << result.p90
+             << ", \"p99_ns\": " << result.p99 << ", \"max_ns\": " << result.max << ", \"mad_ns\": " << result.mad << "}"
+             << (i + 1 < m_results.size() ? "," : "") << std::endl;
+    }
+    file << "]" << std::endl << "}" << std::endl;
+
+    std::cout << "Results written to " << path << std::endl;
+    return 0;
+}
+
+int BenchmarkHarness::Compare(const std::string& baselinePath, std::ostream& stream) const
+{
+    std::map<std::string, double> baseline;
+    if (!ReadMedians(baselinePath, baseline))
+    {
+        std::cerr << "Failed to read " << baselinePath << std::endl;
+        return -1;
+    }
+
+    stream << std::endl << "Compared to " << baselinePath << " (median):" << std::endl;
+    for (const Result& result : m_results)
+    {
+        auto it = baseline.find(result.name);
+        if (it == baseline.end() || it->second <= 0.0)
+        {
+            stream << std::left << std::setw(48) << result.name << " new" << std::endl;
+            continue;
+        }
+
+        double change = 100.0 * (result.median - it->second) / it->second;
+        // Below the noise of the run, don't make a fuss about it
+        double noise = result.median > 0.0 ? 100.0 * result.mad / result.median : 0.0;
+        stream << std::left << std::setw(48) << result.name << " " << std::setw(10) << FormatTime(it->second)
+               << " -> " << std::setw(10) << FormatTime(result.median) << " " << std::showpos << std::fixed
+               << std::setprecision(1) << change << "%" << std::noshowpos << (std::abs(change) <= noise ? " (noise)" : "")
+               << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Small benchmark harness. Each benchmark is run for a number of samples, every
+// sample times a fixed number of iterations of the body. Results are robust
+// statistics over the samples (median, MAD, percentiles), printed as a table
+// and written as JSON, one benchmark per line, so runs can be compared across
+// commits (see --compare).
+class BenchmarkHarness
+{
+public:
+    struct Options
+    {
+        unsigned int warmupSamples = 3;
+        unsigned int minSamples = 20;
+        unsigned int maxSamples = 1000;
+        // Keep sampling until this time is spent (after minSamples)
+        double minTimeS = 0.5;
+        // Only run benchmarks whose name contains this string
+        std::string filter;
+        std::string jsonPath;
+        std::string comparePath;
+    };
+
+    struct Result
+    {
+        std::string name;
+        // Number of items processed by one iteration (cars for example), to get a cost per item
+        unsigned int nbItems = 1;
+        size_t nbSamples = 0;
+        // Time of one iteration, in nanoseconds
+        double min = 0.0;
+        double median = 0.0;
+        double mean = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        // Median absolute deviation, robust to outliers
+        double mad = 0.0;
+    };
+
+    using Function = std::function<void()>;
+
+    BenchmarkHarness() = default;
+    BenchmarkHarness(const Options& options) : m_options(options) {}
+
+    // Parse the common options (--filter, --json, --compare, --min-time, --min-samples, --max-samples).
+    // Returns false if an argument is unknown or malformed.
+    static bool ParseArguments(int argc, char** argv, Options& options);
+    static void PrintUsage(const char* executable);
+
+    bool IsEnabled(const std::string& name) const;
+
+    // setup is called before each sample and is not timed. body is called nbIterations times per sample.
+    void Run(const std::string& name, const Function& setup, const Function& body, unsigned int nbIterations = 1, unsigned int nbItems = 1);
+    void Run(const std::string& name, const Function& body, unsigned int nbIterations = 1, unsigned int nbItems = 1)
+    {
+        Run(name, Function(), body, nbIterations, nbItems);
+    }
+
+    const std::vector<Result>& GetResults() const { return m_results; }
+
+    void PrintSummary(std::ostream& stream) const;
+    // Write the JSON file and compare with the baseline, if asked in the options
+    int Finish() const;
+
+    int WriteJson(const std::string& path) const;
+    // Print the median change of each benchmark found in a JSON written by WriteJson
+    int Compare(const std::string& baselinePath, std::ostream& stream) const;
+
+    static Result ComputeStatistics(const std::string& name, std::vector<double>& samples, unsigned int nbItems);
+
+private:
+    Options m_options;
+    std::vector<Result> m_results;
+};
+
+// Keep the compiler from optimizing away a computation whose result is unused
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
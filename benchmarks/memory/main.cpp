@@ -0,0 +1,144 @@
+#include <racingGame/racingEnvironment.h>
+#include <metrics/memoryReport.h>
+
+#include <Box2D/Box2D.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+// Memory footprint of a training environment for 1, 10 and 100 cars, after
+// some steps so every buffer reached its working size. The accounted bytes
+// (MemoryReport) are cross-checked with the growth of the resident set size
+// of the process while several environments are alive, which also includes
+// the heap overhead. Tells how many environments fit in the RAM of a node.
+// The resident set size is lower than the report when memory freed by the
+// previous environments is reused, or pages are never touched (the Box2D
+// stack allocator is mostly unused).
+
+namespace
+{
+    constexpr unsigned int SEED = 42;
+
+    const std::vector<unsigned int> NB_CARS = { 1, 10, 100 };
+
+    // Resident set size of the process, 0 when unknown
+    size_t GetResidentBytes()
+    {
+#ifdef __linux__
+        std::ifstream statm("/proc/self/statm");
+        size_t totalPages = 0;
+        size_t residentPages = 0;
+        if (statm >> totalPages >> residentPages)
+            return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+        return 0;
+    }
+
+    std::unique_ptr<RacingEnvironment> CreateEnvironment(unsigned int nbCars, unsigned int seed, unsigned int nbSteps)
+    {
+        RacingEnvironment::Config config;
+        config.nbCars = nbCars;
+        config.seed = seed;
+        config.maxEpisodeSteps = 0;
+        auto environment = std::make_unique<RacingEnvironment>(config);
+        if (environment->Initialize() != 0)
+            return nullptr;
+
+        environment->Reset();
+        std::default_random_engine generator(seed);
+        std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+        std::vector<float> actions(nbCars * RacingEnvironment::ACTION_SIZE);
+        for (unsigned int step = 0; step < nbSteps; ++step)
+        {
+            // Mostly gas, random steering
+            for (unsigned int car = 0; car < nbCars; ++car)
+            {
+                float* action = actions.data() + car * RacingEnvironment::ACTION_SIZE;
+                action[0] = 0.5f;
+                action[1] = 0.0f;
+                action[2] = 2.0f * distribution(generator) - 1.0f;
+            }
+            environment->Step(actions.data());
+            if (environment->IsDone())
+                environment->Reset();
+        }
+        return environment;
+    }
+
+    void PrintUsage()
+    {
+        std::cout << "Usage: MemoryBenchmark [--steps <n>] [--environments <n>]" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int nbSteps = 300;
+    unsigned int nbEnvironments = 8;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--steps") == 0 && hasValue)
+            nbSteps = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--environments") == 0 && hasValue)
+            nbEnvironments = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+    if (nbEnvironments == 0)
+    {
+        PrintUsage();
+        return -1;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (unsigned int nbCars : NB_CARS)
+    {
+        // Several environments alive at once, like in a pool, for the resident set size
+        const size_t residentBefore = GetResidentBytes();
+        std::vector<std::unique_ptr<RacingEnvironment>> environments;
+        for (unsigned int i = 0; i < nbEnvironments; ++i)
+        {
+            environments.push_back(CreateEnvironment(nbCars, SEED + i, nbSteps));
+            if (environments.back() == nullptr)
+            {
+                std::cerr << "Failed to initialize the environment" << std::endl;
+                return -1;
+            }
+        }
+        const size_t residentAfter = GetResidentBytes();
+
+        MemoryReport report;
+        environments.front()->AddMemoryUsage(report);
+        const b2World* world = environments.front()->GetGameManager().GetWorld();
+
+        std::cout << nbCars << " cars, after " << nbSteps << " steps:" << std::endl;
+        report.Print(std::cout);
+        std::cout << "    " << report.GetTotal() / 1024.0 << " KiB per environment, "
+                  << static_cast<double>(report.GetTotal()) / nbCars / 1024.0 << " KiB per car" << std::endl;
+        std::cout << "    box2d stack allocator peak: " << world->GetStackAllocatorPeak() << " / " << b2_stackSize << " bytes" << std::endl;
+        if (residentAfter > 0)
+        {
+            const double residentPerEnvironment = residentAfter > residentBefore ?
+                static_cast<double>(residentAfter - residentBefore) / nbEnvironments : 0.0;
+            std::cout << "    resident set size growth: " << residentPerEnvironment / 1024.0 << " KiB per environment (over "
+                      << nbEnvironments << " environments)" << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,350 @@
+#include <harness/benchmarkHarness.h>
+
+#include <racingGame/car.h>
+#include <racingGame/controllers/cruiseCarController.h>
+#include <racingGame/gameManager.h>
+#include <racingGame/scenarios/scenario.h>
+#include <racingGame/scenarios/spawningStrategy.h>
+#include <metrics/perfCounters.h>
+#include <metrics/physicsProfile.h>
+#include <utils/randomEngine.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// How the cost of a frame grows with the number of cars, for each spawning
+// strategy. Each phase of GameManager::Step is timed separately (see
+// FrameTimings), the curve is printed and can be written as CSV.
+// Total is the median frame, phases are means per frame.
+// With --perf, hardware counters are read around the same phases and
+// reported per car next to the time, to tell compute bound phases (high
+// IPC) from memory bound ones (cache misses).
+// With --physics-profile, Box2D own breakdown of the physics phase is printed
+// (b2Profile), with the number of contacts and islands per step.
+
+namespace
+{
+    constexpr unsigned int SEED = 42;
+    constexpr unsigned int WARMUP_FRAMES = 30;
+
+    const std::vector<unsigned int> NB_CARS = { 1, 2, 5, 10, 20, 50, 100, 200, 500 };
+
+    const std::vector<std::pair<SpawningStrategy::Strategy, const char*>> STRATEGIES = {
+        { SpawningStrategy::Strategy_AllOnStart, "AllOnStart" },
+        { SpawningStrategy::Strategy_Random, "Random" },
+        { SpawningStrategy::Strategy_Spaced, "Spaced" },
+        { SpawningStrategy::Strategy_Formula1, "Formula1" }
+    };
+
+    // Spawns nbCars cars once, and again after each reset
+    class ScalingScenario : public Scenario
+    {
+    public:
+        ScalingScenario(unsigned int nbCars, SpawningStrategy::Strategy strategy)
+            : m_nbCars(nbCars)
+            , m_strategy(strategy)
+        {
+        }
+
+        virtual void Update(GameManager& manager) override
+        {
+            if (m_nbSpawnedCars == m_nbCars)
+                return;
+            if (m_nbSpawnedCars == 0)
+                SpawningStrategy::ResetInternalVariables();
+            while (m_nbSpawnedCars < m_nbCars)
+                SpawningStrategy::SpawnVehicle(manager, m_strategy);
+        }
+
+        virtual void OnVehicleSpawned(Car* car) override
+        {
+            car->AttachController(&m_controller);
+            m_nbSpawnedCars++;
+        }
+
+        virtual void OnVehicleUnspawned(Car* car) override
+        {
+            car->DetachController();
+            m_nbSpawnedCars--;
+        }
+
+    private:
+        // Stateless, shared by all the cars
+        CruiseCarController m_controller;
+        unsigned int m_nbCars;
+        unsigned int m_nbSpawnedCars = 0;
+        SpawningStrategy::Strategy m_strategy;
+    };
+
+    struct ScalingPoint
+    {
+        const char* strategy;
+        unsigned int nbCars;
+        unsigned int nbResets;
+        BenchmarkHarness::Result total;
+        std::vector<BenchmarkHarness::Result> phases;
+
+        // Sums over all the measured frames, when counters are enabled
+        bool hasCounters = false;
+        unsigned int nbFrames = 0;
+        PerfCounterValues totalCounters;
+        std::array<PerfCounterValues, STEP_PHASE_COUNT> phaseCounters{};
+
+        PhysicsProfile physicsProfile;
+    };
+
+    GameConfig CreateHeadlessConfig()
+    {
+        GameConfig config;
+        config.enableRendering = false;
+        config.humanPlay = false;
+        config.attachCamera = false;
+        config.debugInfo = false;
+        return config;
+    }
+
+    int Measure(SpawningStrategy::Strategy strategy, const char* strategyName, unsigned int nbCars, unsigned int nbFrames, bool perfCounters, ScalingPoint& point)
+    {
+        std::default_random_engine generator(SEED);
+        RandomEngine::ScopedGenerator scopedGenerator(generator);
+
+        ScalingScenario scenario(nbCars, strategy);
+        GameManager game(CreateHeadlessConfig(), &scenario);
+        int errorCode = game.Setup();
+        if (errorCode != 0)
+            return errorCode;
+
+        const float dt = GameConfigSingleton::GetInstance()->m_gameConfig.GetDt();
+        for (unsigned int i = 0; i < WARMUP_FRAMES; ++i)
+            game.Step(dt);
+
+        game.EnableFrameTimings(true);
+        point.hasCounters = perfCounters && game.EnablePerfCounters(true) == 0;
+        point.nbFrames = nbFrames;
+        std::vector<double> totals;
+        std::vector<std::vector<double>> phases(STEP_PHASE_COUNT);
+        point.nbResets = 0;
+        for (unsigned int i = 0; i < nbFrames; ++i)
+        {
+            game.Step(dt);
+            const FrameTimings& timings = game.GetFrameTimings();
+            totals.push_back(static_cast<double>(timings.totalNs));
+            for (size_t phase = 0; phase < STEP_PHASE_COUNT; ++phase)
+                phases[phase].push_back(static_cast<double>(timings.phaseNs[phase]));
+            if (timings[StepPhase::Reset] > 0)
+                point.nbResets++;
+
+            if (point.hasCounters)
+            {
+                const PerfCounterValues zero;
+                point.totalCounters.AddDelta(zero, timings.totalCounters);
+                for (size_t phase = 0; phase < STEP_PHASE_COUNT; ++phase)
+                    point.phaseCounters[phase].AddDelta(zero, timings.phaseCounters[phase]);
+            }
+        }
+
+        point.strategy = strategyName;
+        point.nbCars = nbCars;
+        point.total = BenchmarkHarness::ComputeStatistics("total", totals, nbCars);
+        point.physicsProfile = game.GetPhysicsProfile();
+        point.phases.clear();
+        for (size_t phase = 0; phase < STEP_PHASE_COUNT; ++phase)
+            point.phases.push_back(BenchmarkHarness::ComputeStatistics(GetStepPhaseName(static_cast<StepPhase>(phase)), phases[phase], nbCars));
+        return 0;
+    }
+
+    void PrintHeader()
+    {
+        std::cout << std::left << std::setw(12) << "strategy" << std::setw(6) << "cars" << std::setw(11) << "total us"
+                  << std::setw(11) << "p99 us" << std::setw(11) << "us/car";
+        for (size_t phase = 0; phase < STEP_PHASE_COUNT; ++phase)
+            std::cout << std::setw(14) << GetStepPhaseName(static_cast<StepPhase>(phase));
+        std::cout << "resets" << std::endl;
+    }
+
+    void PrintPoint(const ScalingPoint& point)
+    {
+        std::cout << std::left << std::fixed << std::setprecision(1) << std::setw(12) << point.strategy << std::setw(6) << point.nbCars
+                  << std::setw(11) << point.total.median / 1e3 << std::setw(11) << point.total.p99 / 1e3
+                  << std::setw(11) << std::setprecision(2) << point.total.median / 1e3 / point.nbCars << std::setprecision(1);
+        // Means, some phases only run every few frames (observations)
+        for (const BenchmarkHarness::Result& phase : point.phases)
+            std::cout << std::setw(14) << phase.mean / 1e3;
+        std::cout << point.nbResets << std::endl;
+    }
+
+    // One line per phase that ran, values per car and per frame
+    void PrintCounters(const ScalingPoint& point)
+    {
+        if (!point.hasCounters)
+            return;
+
+        const double perCar = 1.0 / (static_cast<double>(point.nbFrames) * point.nbCars);
+        auto printLine = [&point, perCar](const char* name, double meanNs, const PerfCounterValues& counters)
+        {
+            double cycles = static_cast<double>(counters[PerfCounter::Cycles]);
+            double instructions = static_cast<double>(counters[PerfCounter::Instructions]);
+            std::cout << "    " << std::left << std::fixed << std::setw(14) << name
+                      << std::setprecision(2) << std::setw(11) << meanNs / 1e3 / point.nbCars
+                      << std::setprecision(0) << std::setw(13) << cycles * perCar
+                      << std::setprecision(2) << std::setw(8) << (cycles > 0.0 ? instructions / cycles : 0.0)
+                      << std::setw(14) << counters[PerfCounter::L1DMisses] * perCar
+                      << std::setw(14) << counters[PerfCounter::LLCMisses] * perCar
+                      << std::setw(14) << counters[PerfCounter::BranchMisses] * perCar << std::endl;
+        };
+
+        std::cout << "    " << std::left << std::setw(14) << "counters" << std::setw(11) << "us/car" << std::setw(13) << "cycles/car"
+                  << std::setw(8) << "IPC" << std::setw(14) << "l1d miss/car" << std::setw(14) << "llc miss/car"
+                  << std::setw(14) << "br miss/car" << std::endl;
+        printLine("total", point.total.mean, point.totalCounters);
+        for (size_t phase = 0; phase < STEP_PHASE_COUNT; ++phase)
+        {
+            if (point.phaseCounters[phase][PerfCounter::Cycles] == 0)
+                continue;
+            printLine(point.phases[phase].name.c_str(), point.phases[phase].mean, point.phaseCounters[phase]);
+        }
+        std::cout << std::setprecision(1);
+    }
+
+    // Median and p99 of each b2Profile phase, in us
+    void PrintPhysicsProfile(const ScalingPoint& point)
+    {
+        const PhysicsProfile& profile = point.physicsProfile;
+        std::cout << "    box2d p50/p99 us:";
+        for (size_t phase = 0; phase < PHYSICS_PHASE_COUNT; ++phase)
+        {
+            const RollingHistogram& histogram = profile.GetPhase(static_cast<PhysicsPhase>(phase));
+            std::cout << " " << GetPhysicsPhaseName(static_cast<PhysicsPhase>(phase)) << " "
+                      << histogram.GetPercentile(0.5) * 1e3 << "/" << histogram.GetPercentile(0.99) * 1e3;
+        }
+        std::cout << std::endl;
+        std::cout << "    contacts mean/max: " << profile.GetContacts().GetMean() << "/" << profile.GetContacts().GetMax()
+                  << ", islands mean/max: " << profile.GetIslands().GetMean() << "/" << profile.GetIslands().GetMax() << std::endl;
+    }
+
+    int WriteCsv(const std::string& path, const std::vector<ScalingPoint>& points)
+    {
+        std::ofstream file(path);
+        if (!file)
+        {
+            std::cerr << "Failed to open " << path << std::endl;
+            return -1;
+        }
+
+        file << "strategy,cars,total_median_ns,total_p99_ns,total_mean_ns";
+        for (size_t phase = 0; phase < STEP_PHASE_COUNT; ++phase)
+        {
+            const char* name = GetStepPhaseName(static_cast<StepPhase>(phase));
+            file << "," << name << "_median_ns," << name << "_mean_ns";
+        }
+        file << ",resets";
+        // Counters are means per frame, for all the cars
+        const bool hasCounters = !points.empty() && points.front().hasCounters;
+        if (hasCounters)
+        {
+            for (size_t phase = 0; phase <= STEP_PHASE_COUNT; ++phase)
+            {
+                const char* name = phase == STEP_PHASE_COUNT ? "total" : GetStepPhaseName(static_cast<StepPhase>(phase));
+                for (size_t counter = 0; counter < PERF_COUNTER_COUNT; ++counter)
+                    file << "," << name << "_" << GetPerfCounterName(static_cast<PerfCounter>(counter));
+            }
+        }
+        file << std::endl;
+
+        for (const ScalingPoint& point : points)
+        {
+            file << point.strategy << "," << point.nbCars << "," << point.total.median << "," << point.total.p99 << "," << point.total.mean;
+            for (const BenchmarkHarness::Result& phase : point.phases)
+                file << "," << phase.median << "," << phase.mean;
+            file << "," << point.nbResets;
+            if (hasCounters)
+            {
+                for (size_t phase = 0; phase <= STEP_PHASE_COUNT; ++phase)
+                {
+                    const PerfCounterValues& counters = phase == STEP_PHASE_COUNT ? point.totalCounters : point.phaseCounters[phase];
+                    for (uint64_t value : counters.values)
+                        file << "," << (point.hasCounters ? static_cast<double>(value) / point.nbFrames : 0.0);
+                }
+            }
+            file << std::endl;
+        }
+        std::cout << "Scaling curve written to " << path << std::endl;
+        return 0;
+    }
+
+    void PrintUsage()
+    {
+        std::cout << "Usage: ScalingBenchmark [--frames <n>] [--max-cars <n>] [--strategy <name>] [--csv <output.csv>] [--perf] [--physics-profile]" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int nbFrames = 200;
+    unsigned int maxCars = NB_CARS.back();
+    std::string strategyFilter;
+    std::string csvPath;
+    bool perfCounters = false;
+    bool physicsProfile = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--frames") == 0 && hasValue)
+            nbFrames = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--max-cars") == 0 && hasValue)
+            maxCars = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--strategy") == 0 && hasValue)
+            strategyFilter = argv[++i];
+        else if (strcmp(argv[i], "--csv") == 0 && hasValue)
+            csvPath = argv[++i];
+        else if (strcmp(argv[i], "--perf") == 0)
+            perfCounters = true;
+        else if (strcmp(argv[i], "--physics-profile") == 0)
+            physicsProfile = true;
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+    nbFrames = std::max(nbFrames, 1u);
+
+    PrintHeader();
+    std::vector<ScalingPoint> points;
+    for (const auto& strategy : STRATEGIES)
+    {
+        if (!strategyFilter.empty() && strategyFilter != strategy.second)
+            continue;
+
+        for (unsigned int nbCars : NB_CARS)
+        {
+            if (nbCars > maxCars)
+                break;
+
+            ScalingPoint point;
+            int errorCode = Measure(strategy.first, strategy.second, nbCars, nbFrames, perfCounters, point);
+            if (errorCode != 0)
+                return errorCode;
+            PrintPoint(point);
+            PrintCounters(point);
+            if (physicsProfile)
+                PrintPhysicsProfile(point);
+            // Not permitted here, no need to try again for each point
+            perfCounters = point.hasCounters;
+            points.push_back(std::move(point));
+        }
+    }
+
+    if (!csvPath.empty())
+        return WriteCsv(csvPath, points);
+    return 0;
+}
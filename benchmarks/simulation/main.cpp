@@ -0,0 +1,199 @@
+#include <harness/benchmarkHarness.h>
+
+#include <racingGame/car.h>
+#include <racingGame/carState.h>
+#include <racingGame/constants.h>
+#include <racingGame/gameManager.h>
+#include <racingGame/racingEnvironment.h>
+#include <racingGame/scenarios/trainingScenario.h>
+#include <racingGame/track.h>
+#include <rasterizer/lidar.h>
+#include <rasterizer/occupancyGrid.h>
+#include <rasterizer/softwareRasterizer.h>
+#include <utils/randomEngine.h>
+
+#include <Box2D/Box2D.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Hot paths of the simulation, headless. Every race is seeded, so two runs
+// (and two commits) benchmark the same tracks and the same car placements.
+
+namespace
+{
+    constexpr unsigned int SEED = 42;
+    // Frames simulated before measuring, so cars are moving and touching
+    constexpr unsigned int WARMUP_FRAMES = 120;
+
+    GameConfig CreateHeadlessConfig()
+    {
+        GameConfig config;
+        config.enableRendering = false;
+        config.humanPlay = false;
+        config.attachCamera = false;
+        config.debugInfo = false;
+        return config;
+    }
+
+    // A headless race of nbCars cars driving forward
+    struct Race
+    {
+        Race(unsigned int nbCars)
+            : scenario(nbCars, SpawningStrategy::Strategy_Formula1)
+            , game(CreateHeadlessConfig(), &scenario)
+        {
+        }
+
+        int Initialize()
+        {
+            int errorCode = game.Setup();
+            if (errorCode != 0)
+                return errorCode;
+            scenario.Update(game);
+
+            CarAction action;
+            action.gas = 0.5f;
+            for (unsigned int i = 0; i < scenario.GetNbCars(); ++i)
+                scenario.GetController(i).SetAction(action);
+
+            const float dt = GameConfigSingleton::GetInstance()->m_gameConfig.GetDt();
+            for (unsigned int i = 0; i < WARMUP_FRAMES; ++i)
+                game.Step(dt);
+            return 0;
+        }
+
+        TrainingScenario scenario;
+        GameManager game;
+    };
+
+    void RunRaceBenchmarks(BenchmarkHarness& harness, unsigned int nbCars)
+    {
+        const std::string suffix = " (" + std::to_string(nbCars) + (nbCars > 1 ? " cars)" : " car)");
+        Race race(nbCars);
+        if (race.Initialize() != 0)
+            return;
+
+        const float dt = GameConfigSingleton::GetInstance()->m_gameConfig.GetDt();
+        GameManager& game = race.game;
+        const auto& cars = game.GetCars();
+        const Track::Path& path = game.GetTrack()->GetPath();
+
+        harness.Run("b2World::Step" + suffix, [&game, dt]()
+        {
+            game.GetWorld()->Step(dt, Constants::VELOCITY_ITERATIONS, Constants::POSITION_ITERATIONS);
+        }, 1, nbCars);
+
+        harness.Run("Car::Step" + suffix, [&cars, dt]()
+        {
+            for (const auto& it : cars)
+                it.second->Step(dt);
+        }, 10, nbCars);
+
+        harness.Run("CarState::GenerateState" + suffix, [&cars, &path]()
+        {
+            unsigned int i = 0;
+            for (const auto& it : cars)
+            {
+                CarState state = CarState::GenerateState(*it.second, path, it.second->GetCurrentTrackIndex(), false, i++, cars);
+                DoNotOptimize(state);
+            }
+        }, 1, nbCars);
+
+        harness.Run("GameManager::UpdateCarsRanking" + suffix, [&game]()
+        {
+            game.UpdateCarsRanking();
+        }, 10, nbCars);
+
+        harness.Run("GameManager::Step" + suffix, [&game, dt]()
+        {
+            game.Step(dt);
+        }, 1, nbCars);
+
+        // One 96x96 frame per car
+        SoftwareRasterizer rasterizer;
+        rasterizer.SetTrack(*game.GetTrack());
+        std::vector<const Car*> egoCars;
+        for (const auto& it : cars)
+            egoCars.push_back(it.second);
+        std::vector<uint8_t> pixels(egoCars.size() * rasterizer.GetFrameSize());
+        // Default 16x16 grid per car
+        OccupancyGrid grid;
+        grid.SetTrack(*game.GetTrack());
+        std::vector<float> gridValues(grid.GetSize());
+        harness.Run("OccupancyGrid::Compute" + suffix, [&grid, &cars, &gridValues]()
+        {
+            for (const auto& it : cars)
+                grid.Compute(*it.second, cars, gridValues.data());
+            DoNotOptimize(gridValues[0]);
+        }, 1, nbCars);
+
+        Lidar lidar;
+        lidar.SetTrack(*game.GetTrack());
+        std::vector<float> distances(lidar.GetSize());
+        harness.Run("Lidar::Compute" + suffix, [&lidar, &cars, &distances]()
+        {
+            for (const auto& it : cars)
+                lidar.Compute(*it.second, cars, distances.data());
+            DoNotOptimize(distances[0]);
+        }, 1, nbCars);
+
+        harness.Run("SoftwareRasterizer::Render" + suffix, [&rasterizer, &egoCars, &cars, &pixels]()
+        {
+            rasterizer.Render(egoCars, cars, pixels.data());
+            DoNotOptimize(pixels[0]);
+        }, 1, nbCars);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkHarness::Options options;
+    if (!BenchmarkHarness::ParseArguments(argc, argv, options))
+    {
+        BenchmarkHarness::PrintUsage(argv[0]);
+        return -1;
+    }
+    BenchmarkHarness harness(options);
+
+    std::default_random_engine generator(SEED);
+    RandomEngine::ScopedGenerator scopedGenerator(generator);
+
+    {
+        // Holds the singletons for the track benchmark
+        Race race(1);
+        if (race.Initialize() != 0)
+            return -1;
+
+        Track track;
+        harness.Run("Track::GenerateTrack", [&track]() { track.ClearTrack(); }, [&track]()
+        {
+            // Like GameManager::Reset, retry until a track is valid
+            while (!track.GenerateTrack());
+        });
+    }
+
+    for (unsigned int nbCars : {1u, 20u, 200u})
+        RunRaceBenchmarks(harness, nbCars);
+
+    for (unsigned int nbCars : {1u, 20u})
+    {
+        RacingEnvironment::Config config;
+        config.nbCars = nbCars;
+        config.seed = SEED;
+        RacingEnvironment environment(config);
+        if (environment.Initialize() != 0)
+            return -1;
+        // The first reset reuses the track generated by Initialize
+        environment.Reset();
+
+        harness.Run("RacingEnvironment::Reset (" + std::to_string(nbCars) + (nbCars > 1 ? " cars)" : " car)"), [&environment]()
+        {
+            environment.Reset();
+        }, 1, nbCars);
+    }
+
+    return harness.Finish();
+}
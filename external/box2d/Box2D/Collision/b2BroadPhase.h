@@ -96,6 +96,9 @@ public:
 	/// Get the balance of the embedded tree.
 	int32 GetTreeBalance() const;
 
+	/// Get the number of bytes reserved by the tree, the move and the pair buffers.
+	int32 GetAllocatedBytes() const;
+
 	/// Get the quality metric of the embedded tree.
 	float32 GetTreeQuality() const;
 
@@ -171,6 +174,11 @@ inline int32 b2BroadPhase::GetTreeHeight() const
 	return m_tree.GetHeight();
 }
 
+inline int32 b2BroadPhase::GetAllocatedBytes() const
+{
+	return m_tree.GetAllocatedBytes() + m_moveCapacity * int32(sizeof(int32)) + m_pairCapacity * int32(sizeof(b2Pair));
+}
+
 inline int32 b2BroadPhase::GetTreeBalance() const
 {
 	return m_tree.GetMaxBalance();
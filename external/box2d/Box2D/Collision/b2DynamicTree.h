@@ -112,6 +112,9 @@ public:
 	/// in height of the two children of a node.
 	int32 GetMaxBalance() const;
 
+	/// Get the number of bytes reserved for the nodes.
+	int32 GetAllocatedBytes() const { return m_nodeCapacity * int32(sizeof(b2TreeNode)); }
+
 	/// Get the ratio of the sum of the node areas to the root area.
 	float32 GetAreaRatio() const;
 
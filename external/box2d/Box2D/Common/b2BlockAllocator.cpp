@@ -201,6 +201,11 @@ void b2BlockAllocator::Free(void* p, int32 size)
 	m_freeLists[index] = block;
 }
 
+int32 b2BlockAllocator::GetAllocatedBytes() const
+{
+	return m_chunkCount * b2_chunkSize + m_chunkSpace * int32(sizeof(b2Chunk));
+}
+
 void b2BlockAllocator::Clear()
 {
 	for (int32 i = 0; i < m_chunkCount; ++i)
@@ -46,6 +46,9 @@ public:
 
 	void Clear();
 
+	/// Get the number of bytes reserved by the chunks (used or not).
+	int32 GetAllocatedBytes() const;
+
 private:
 
 	b2Chunk* m_chunks;
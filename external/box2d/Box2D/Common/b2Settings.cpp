@@ -23,17 +23,36 @@
 
 b2Version b2_version = {2, 3, 2};
 
-// Memory allocators. Modify these to use your own allocator.
-void* b2Alloc(int32 size)
+static void* b2AllocDefault(int32 size)
 {
 	return malloc(size);
 }
 
-void b2Free(void* mem)
+static void b2FreeDefault(void* mem)
 {
 	free(mem);
 }
 
+static b2AllocFunction b2_allocFunction = b2AllocDefault;
+static b2FreeFunction b2_freeFunction = b2FreeDefault;
+
+// Memory allocators. Modify these or call b2SetAllocator to use your own allocator.
+void* b2Alloc(int32 size)
+{
+	return b2_allocFunction(size);
+}
+
+void b2Free(void* mem)
+{
+	b2_freeFunction(mem);
+}
+
+void b2SetAllocator(b2AllocFunction allocFunction, b2FreeFunction freeFunction)
+{
+	b2_allocFunction = allocFunction;
+	b2_freeFunction = freeFunction;
+}
+
 // You can modify this to use your logging facility.
 void b2Log(const char* string, ...)
 {
@@ -137,6 +137,14 @@ void* b2Alloc(int32 size);
 /// If you implement b2Alloc, you should also implement this function.
 void b2Free(void* mem);
 
+/// Functions called by b2Alloc and b2Free, malloc and free by default.
+typedef void* (*b2AllocFunction)(int32 size);
+typedef void (*b2FreeFunction)(void* mem);
+
+/// Replace the functions called by b2Alloc and b2Free. Call it before creating any world:
+/// memory allocated by one function must be freed by its pair.
+void b2SetAllocator(b2AllocFunction allocFunction, b2FreeFunction freeFunction);
+
 /// Logging function.
 void b2Log(const char* string, ...);
 
@@ -64,8 +64,10 @@ float32 b2Timer::GetMilliseconds() const
 
 #elif defined(__linux__) || defined (__APPLE__)
 
-#include <sys/time.h>
+#include <time.h>
 
+// Monotonic clock with a nanosecond resolution, gettimeofday only has
+// microseconds which is the order of magnitude of the profiled phases.
 b2Timer::b2Timer()
 {
     Reset();
@@ -73,34 +75,19 @@ b2Timer::b2Timer()
 
 void b2Timer::Reset()
 {
-    timeval t;
-    gettimeofday(&t, 0);
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
     m_start_sec = t.tv_sec;
-    m_start_usec = t.tv_usec;
+    m_start_nsec = t.tv_nsec;
 }
 
 float32 b2Timer::GetMilliseconds() const
 {
-    timeval t;
-    gettimeofday(&t, 0);
-	time_t start_sec = m_start_sec;
-	suseconds_t start_usec = m_start_usec;
-	
-	// http://www.gnu.org/software/libc/manual/html_node/Elapsed-Time.html
-	if (t.tv_usec < start_usec)
-	{
-		int nsec = (start_usec - t.tv_usec) / 1000000 + 1;
-		start_usec -= 1000000 * nsec;
-		start_sec += nsec;
-	}
-	
-	if (t.tv_usec - start_usec > 1000000)
-	{
-		int nsec = (t.tv_usec - start_usec) / 1000000;
-		start_usec += 1000000 * nsec;
-		start_sec -= nsec;
-	}
-	return 1000.0f * (t.tv_sec - start_sec) + 0.001f * (t.tv_usec - start_usec);
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    long long seconds = static_cast<long long>(t.tv_sec) - static_cast<long long>(m_start_sec);
+    long long nanoseconds = static_cast<long long>(t.tv_nsec) - static_cast<long long>(m_start_nsec);
+    return float32(1000.0 * seconds + 1e-6 * nanoseconds);
 }
 
 #else
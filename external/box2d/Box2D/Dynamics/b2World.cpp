@@ -61,6 +61,7 @@ b2World::b2World(const b2Vec2& gravity)
 	m_contactManager.m_allocator = &m_blockAllocator;
 
 	memset(&m_profile, 0, sizeof(b2Profile));
+	m_islandCount = 0;
 }
 
 b2World::~b2World()
@@ -388,6 +389,7 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveInit = 0.0f;
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
+	m_islandCount = 0;
 
 	// Size the island for the worst case.
 	b2Island island(m_bodyCount,
@@ -529,6 +531,7 @@ void b2World::Solve(const b2TimeStep& step)
 
 		b2Profile profile;
 		island.Solve(&profile, step, m_gravity, m_allowSleep);
+		++m_islandCount;
 		m_profile.solveInit += profile.solveInit;
 		m_profile.solveVelocity += profile.solveVelocity;
 		m_profile.solvePosition += profile.solvePosition;
@@ -1283,6 +1286,21 @@ float32 b2World::GetTreeQuality() const
 	return m_contactManager.m_broadPhase.GetTreeQuality();
 }
 
+int32 b2World::GetBlockAllocatorBytes() const
+{
+	return m_blockAllocator.GetAllocatedBytes();
+}
+
+int32 b2World::GetBroadPhaseBytes() const
+{
+	return m_contactManager.m_broadPhase.GetAllocatedBytes();
+}
+
+int32 b2World::GetStackAllocatorPeak() const
+{
+	return m_stackAllocator.GetMaxAllocation();
+}
+
 void b2World::ShiftOrigin(const b2Vec2& newOrigin)
 {
 	b2Assert((m_flags & e_locked) == 0);
@@ -169,6 +169,9 @@ public:
 	/// Get the number of contacts (each may have 0 or more contact points).
 	int32 GetContactCount() const;
 
+	/// Get the number of islands solved during the last step.
+	int32 GetIslandCount() const;
+
 	/// Get the height of the dynamic tree.
 	int32 GetTreeHeight() const;
 
@@ -179,6 +182,17 @@ public:
 	/// The minimum is 1.
 	float32 GetTreeQuality() const;
 
+	/// Get the number of bytes reserved by the small object allocator
+	/// (bodies, fixtures, shapes, joints and contacts).
+	int32 GetBlockAllocatorBytes() const;
+
+	/// Get the number of bytes reserved by the broad-phase.
+	int32 GetBroadPhaseBytes() const;
+
+	/// Get the peak usage of the stack allocator. Its capacity (b2_stackSize)
+	/// is part of the world object itself.
+	int32 GetStackAllocatorPeak() const;
+
 	/// Change the global gravity vector.
 	void SetGravity(const b2Vec2& gravity);
 	
@@ -261,6 +275,7 @@ private:
 	bool m_stepComplete;
 
 	b2Profile m_profile;
+	int32 m_islandCount;
 };
 
 inline b2Body* b2World::GetBodyList()
@@ -308,6 +323,11 @@ inline int32 b2World::GetContactCount() const
 	return m_contactManager.m_contactCount;
 }
 
+inline int32 b2World::GetIslandCount() const
+{
+	return m_islandCount;
+}
+
 inline void b2World::SetGravity(const b2Vec2& gravity)
 {
 	m_gravity = gravity;
@@ -0,0 +1,120 @@
+#pragma once
+
+/*
+ * Plain C API of the headless simulator (libracing), to embed it in other
+ * languages. One RacingEnv is one race of nbCars cars, all driven through the
+ * action buffer. Buffers are owned by the environment and never move until
+ * racing_destroy, so they can be wrapped once without copy (NumPy buffer
+ * protocol, DLPack...). Functions returning int return 0 on success.
+ * No C++ exception crosses the API: a failure (out of memory...) is printed
+ * on stderr and returns -1, NULL, or 0 for the getters. After a failed step or
+ * reset the environment can only be reset or destroyed.
+ *
+ * Typical loop:
+ *   env = racing_create(&config);
+ *   racing_get_actions(env, &actions); racing_get_observations(env, &observations);
+ *   racing_reset(env);
+ *   while (...) { write actions.data; racing_step(env); read observations.data; }
+ *   racing_destroy(env);
+ */
+
+#include <stdint.h>
+
+#ifdef WIN32
+    #ifdef RACING_BUILDING_LIBRARY
+        #define RACING_API __declspec(dllexport)
+    #else
+        #define RACING_API __declspec(dllimport)
+    #endif
+#else
+    #define RACING_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped each time a signature or a struct layout changes */
+#define RACING_API_VERSION 3
+
+#define RACING_MAX_DIMS 2
+
+typedef struct RacingEnv RacingEnv;
+
+typedef enum RacingDataType
+{
+    RACING_DTYPE_FLOAT32 = 0,
+    RACING_DTYPE_UINT8 = 1
+} RacingDataType;
+
+/* Same values as SpawningStrategy::Strategy */
+typedef enum RacingSpawningStrategy
+{
+    RACING_SPAWN_ALL_ON_START = 0,
+    RACING_SPAWN_RANDOM = 1,
+    RACING_SPAWN_SPACED = 2,
+    RACING_SPAWN_FORMULA1 = 3
+} RacingSpawningStrategy;
+
+typedef struct RacingConfig
+{
+    uint32_t nbCars;
+    uint32_t seed;
+    /* Number of frames simulated by each racing_step, actions are held */
+    uint32_t frameSkip;
+    /* 0 means no limit */
+    uint32_t maxEpisodeSteps;
+    int32_t spawningStrategy;
+    /* Cells per side of the occupancy grid appended to each observation, 0 for none */
+    uint32_t gridSize;
+    /* Meters per cell of the occupancy grid */
+    float gridCellSize;
+    /* Rays of the lidar appended after the grid (2 x lidarRays distances), 0 for none */
+    uint32_t lidarRays;
+    /* Meters, farther hits read as 1 */
+    float lidarRange;
+} RacingConfig;
+
+/* Description of a dense buffer owned by the environment. Strides are in bytes. */
+typedef struct RacingBuffer
+{
+    void* data;
+    int32_t dataType;
+    int32_t ndim;
+    int64_t shape[RACING_MAX_DIMS];
+    int64_t strides[RACING_MAX_DIMS];
+    int32_t readOnly;
+} RacingBuffer;
+
+RACING_API uint32_t racing_get_api_version(void);
+/* CarState part of an observation, the occupancy grid (3 x gridSize x gridSize)
+   and the lidar (2 x lidarRays) follow it */
+RACING_API uint32_t racing_get_observation_size(void);
+RACING_API uint32_t racing_get_action_size(void);
+
+RACING_API void racing_default_config(RacingConfig* config);
+
+/* Returns NULL on failure */
+RACING_API RacingEnv* racing_create(const RacingConfig* config);
+RACING_API void racing_destroy(RacingEnv* env);
+
+/* Start a new episode on a new track */
+RACING_API int racing_reset(RacingEnv* env);
+/* Apply the content of the action buffer and simulate frameSkip frames */
+RACING_API int racing_step(RacingEnv* env);
+
+/* nbCars x observation size, float32, read only */
+RACING_API int racing_get_observations(RacingEnv* env, RacingBuffer* buffer);
+/* nbCars x action size (gas, brake, steer), float32, writable */
+RACING_API int racing_get_actions(RacingEnv* env, RacingBuffer* buffer);
+/* nbCars, float32, read only. Rewards of the last step */
+RACING_API int racing_get_rewards(RacingEnv* env, RacingBuffer* buffer);
+
+RACING_API int racing_is_done(const RacingEnv* env);
+RACING_API uint32_t racing_get_episode_step(const RacingEnv* env);
+/* Bytes reserved by the environment (simulation, cars, track and buffers) */
+RACING_API uint64_t racing_get_memory_usage(const RacingEnv* env);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,31 +1,69 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include <renderable/renderable.h>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <utils/colors.h>
+#include <utils/mpscQueue.h>
 #include <utils/singleton.h>
 
+// Collects debug figures drawn by the game. It only stores them: the view
+// (see RendererGameView) streams the figures into one batch when it draws.
+// Figures can be drawn from any thread: they go through a lock free queue,
+// emptied by Update on the main thread.
 class DebugManager : public Singleton<DebugManager>
 {
 public:
+    // Interned name, see Intern
+    using DebugId = uint32_t;
+    // A figure replaces the previous one with the same key: a name and an index (a car id...)
+    using DebugKey = uint64_t;
 
-    DebugManager(Token) : Singleton() {}
-    ~DebugManager()
+    struct DebugLine
     {
-        Clear();
-    }
+        DebugKey key;
+        glm::vec3 p1;
+        glm::vec3 p2;
+        glm::vec4 color;
+        int frameTimeRemaining;
+    };
+
+    // Lines pushed in one frame before the extra ones are dropped
+    static constexpr uint32_t QUEUE_CAPACITY = 8192;
 
-    bool IsEnabled() { return m_enabled; }
+    DebugManager(Token) : Singleton() {}
+
+    bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
     void Enable(bool enable);
 
     void Clear();
-    void Update();
+    // Take the figures drawn since the last call, then remove figures that have no more time
+    // remaining. Time doesn't pass while paused. Main thread only
+    void Update(bool paused);
+
+    const std::vector<DebugLine>& GetLines() const { return m_lines; }
+    // Lines lost because the queue was full
+    uint64_t GetNbDroppedLines() const { return m_nbDroppedLines.load(std::memory_order_relaxed); }
+
+    // Same id for the same name, for the whole process. Takes a lock: intern once, keep the id
+    static DebugId Intern(const std::string& name);
+    static DebugKey MakeKey(DebugId name, uint32_t index = 0) { return (static_cast<DebugKey>(name) << 32) | index; }
 
-    void DrawLine(const std::string& id, const glm::vec3& p1, const glm::vec3& p2, const glm::vec4& color, int frameTime = 1);
+    void DrawLine(DebugKey key, const glm::vec3& p1, const glm::vec3& p2, const glm::vec4& color, int frameTime = 1);
 
     // Duplicate helper functions
+    void DrawLine(DebugKey key, const glm::vec2& p1, const glm::vec2& p2, Colors color, int frameTime = 1)
+    {
+        DrawLine(key, glm::vec3(p1.x, p1.y, 0.0f), glm::vec3(p2.x, p2.y, 0.0f), ColorsUtils::GetVecColor(color), frameTime);
+    }
+    // By name, interned on each call
+    void DrawLine(const std::string& id, const glm::vec3& p1, const glm::vec3& p2, const glm::vec4& color, int frameTime = 1)
+    {
+        DrawLine(MakeKey(Intern(id)), p1, p2, color, frameTime);
+    }
     void DrawLine(const std::string& id, const glm::vec3& p1, const glm::vec3& p2, Colors color, int frameTime = 1)
     {
         DrawLine(id, p1, p2, ColorsUtils::GetVecColor(color), frameTime);
@@ -40,18 +78,11 @@ public:
     }
 
 private:
-    struct DebugFigure
-    {
-        DebugFigure() = default;
-        ~DebugFigure();
-
-        std::string id;
-        Renderable* renderable = nullptr;
-        int frameTimeRemaining;
-    };
-
-    bool m_enabled;
+    std::atomic<bool> m_enabled = false;
+    std::atomic<uint64_t> m_nbDroppedLines = 0;
 
-    using MapDebugFigures = std::unordered_map<std::string, DebugFigure>;
-    MapDebugFigures m_mapDebugFigures;
-};
\ No newline at end of file
+    MpscQueue<DebugLine, QUEUE_CAPACITY> m_queue;
+    // Alive lines, and where each key is in m_lines
+    std::vector<DebugLine> m_lines;
+    std::unordered_map<DebugKey, uint32_t> m_lineIndexes;
+};
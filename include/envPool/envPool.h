@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <envPool/workStealingThreadPool.h>
+#include <racingGame/racingEnvironment.h>
+
+// Asynchronous pool of RacingEnvironments, in the style of envpool.
+// Send queues actions for any subset of environments, Recv returns the first
+// batchSize environments that finished, whatever the order they were sent in.
+// Episodes that ended are reset on the next Send for this environment (the
+// actions are ignored), inline on the worker, so a slow track generation only
+// delays that environment.
+class EnvPool
+{
+public:
+    struct Config
+    {
+        RacingEnvironment::Config envConfig;
+        unsigned int nbEnvs = 8;
+        // 0 means nbEnvs, which makes Send/Recv synchronous
+        unsigned int batchSize = 0;
+        // 0 means one per hardware thread
+        unsigned int nbThreads = 0;
+        bool pinThreads = false;
+    };
+
+    EnvPool(const Config& config);
+    ~EnvPool();
+
+    // Create the environments and reset them all. Results are available with Recv.
+    int Initialize();
+
+    // actions is nbEnvIds x nbCars x ACTION_SIZE. Environments must not be already running.
+    void Send(const unsigned int* envIds, size_t nbEnvIds, const float* actions);
+    void Send(const float* actions);
+
+    // Block until batchSize environments are done. Outputs must hold batchSize elements:
+    // envIds[batchSize], observations[batchSize x GetObservationSize()],
+    // rewards[batchSize x nbCars], dones[batchSize]. Returns the number of environments received:
+    // when fewer than batchSize were sent and not received yet, it waits for all of them and
+    // returns fewer, 0 (without blocking) when none is in flight.
+    // With pixel observations, the frames are rendered by the workers and copied in
+    // pixels[batchSize x GetPixelObservationSize()] when given.
+    size_t Recv(unsigned int* envIds, float* observations, float* rewards, uint8_t* dones, uint8_t* pixels = nullptr);
+
+    unsigned int GetNbEnvs() const { return m_config.nbEnvs; }
+    unsigned int GetBatchSize() const { return m_config.batchSize; }
+    unsigned int GetNbCars() const { return m_config.envConfig.nbCars; }
+    size_t GetObservationSize() const { return m_config.envConfig.nbCars * RacingEnvironment::GetObservationSize(m_config.envConfig); }
+    size_t GetActionSize() const { return m_config.envConfig.nbCars * RacingEnvironment::ACTION_SIZE; }
+    // Bytes of the frames of an environment, 0 without pixel observations
+    size_t GetPixelObservationSize() const
+    {
+        return m_config.envConfig.pixelObservations ? m_config.envConfig.nbCars * SoftwareRasterizer::GetFrameSize(m_config.envConfig.rasterizer) : 0;
+    }
+
+private:
+    struct EnvSlot
+    {
+        std::unique_ptr<RacingEnvironment> env;
+        std::vector<float> actions;
+        bool running = false;
+        bool needsReset = true;
+    };
+
+    void RunEnv(unsigned int envId);
+
+    Config m_config;
+    std::vector<EnvSlot> m_slots;
+    std::unique_ptr<WorkStealingThreadPool> m_threadPool;
+
+    std::mutex m_doneLock;
+    std::condition_variable m_doneCondition;
+    std::deque<unsigned int> m_doneEnvs;
+    // Sent and not received yet, done or not
+    size_t m_nbInFlight = 0;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool with one task queue per worker. A task is queued on its preferred
+// worker (to keep an environment on the same core when possible), and idle
+// workers steal from the other queues so a slow task never stalls the others.
+class WorkStealingThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    // nbThreads = 0 means one per hardware thread.
+    // pinThreads binds worker i to cpu i (Linux only, ignored elsewhere).
+    WorkStealingThreadPool(unsigned int nbThreads, bool pinThreads);
+    ~WorkStealingThreadPool();
+
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    void Submit(Task task, unsigned int preferredWorker);
+
+    unsigned int GetNbThreads() const { return static_cast<unsigned int>(m_threads.size()); }
+    uint64_t GetNbSteals() const { return m_nbSteals; }
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    void WorkerLoop(unsigned int index);
+    bool PopTask(unsigned int index, Task& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_sleepLock;
+    std::condition_variable m_wakeUp;
+    size_t m_nbQueuedTasks = 0;
+    bool m_stopRequested = false;
+    std::atomic<uint64_t> m_nbSteals = 0;
+};
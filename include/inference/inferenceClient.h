@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Client side of the local inference transport. One connection per client,
+// requests are synchronous: Infer blocks until the server answered. Several
+// requests can be sent at once, the server answers them in order.
+class InferenceClient
+{
+public:
+    InferenceClient(const std::string& socketPath);
+    ~InferenceClient();
+
+    InferenceClient(const InferenceClient&) = delete;
+    InferenceClient& operator=(const InferenceClient&) = delete;
+
+    int Connect();
+    void Disconnect();
+    bool IsConnected() const { return m_fd >= 0; }
+
+    // Send `stateSize` floats and wait for `actionSize` floats back.
+    // Returns false if the connection is lost or the answer is malformed.
+    bool Infer(const float* state, uint32_t stateSize, float* action, uint32_t actionSize);
+    // Same for `count` states, sent in chunks of at most InferenceProtocol::MAX_REQUESTS_PER_SEND
+    // requests, each in a single write followed by the read of its answers: one round trip
+    // per chunk. A chunk usually lands in a single batch of the server, but can be split when
+    // the server batch is smaller or its latency budget expires
+    bool InferBatch(const float* states, uint32_t stateSize, float* actions, uint32_t actionSize, uint32_t count);
+
+private:
+    bool InferChunk(const float* states, uint32_t stateSize, float* actions, uint32_t actionSize, uint32_t count);
+
+    std::string m_socketPath;
+    int m_fd = -1;
+    uint64_t m_nextRequestId = 0;
+    // Messages of a chunk, reused
+    std::vector<char> m_sendBuffer;
+};
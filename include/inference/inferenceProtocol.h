@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Wire format used between InferenceClient and the InferenceServer.
+// Every message is a fixed header followed by `size` floats, in host byte order
+// (both ends always run on the same machine).
+namespace InferenceProtocol
+{
+    constexpr uint32_t REQUEST_MAGIC = 0x52435251;  // "RCRQ"
+    constexpr uint32_t RESPONSE_MAGIC = 0x52435250; // "RCRP"
+
+    // Hard limit to protect the server against garbage
+    constexpr uint32_t MAX_PAYLOAD_SIZE = 4096;
+
+    // A client sends at most this many requests before reading their answers (the default
+    // batch of the server), and at most MAX_RESPONSE_BYTES_PER_SEND of answers: they fit in
+    // the socket buffer, so the server never blocks on a client that is still sending
+    constexpr uint32_t MAX_REQUESTS_PER_SEND = 64;
+    constexpr size_t MAX_RESPONSE_BYTES_PER_SEND = 64 * 1024;
+
+    struct MessageHeader
+    {
+        uint32_t magic;
+        uint32_t size;
+        uint64_t requestId;
+    };
+
+    // Blocking helpers, return false if the peer closed the connection or on error
+    bool SendAll(int fd, const void* data, size_t size);
+    bool ReceiveAll(int fd, void* data, size_t size);
+
+    bool SendMessage(int fd, uint32_t magic, uint64_t requestId, const float* payload, uint32_t size);
+
+    // Returns the connected file descriptor, or -1 on error
+    int ConnectUnixSocket(const char* socketPath);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <inference/inferenceProtocol.h>
+#include <racingGame/carState.h>
+#include <racingGame/carAction.h>
+
+// Reference local inference server. Clients (a RemoteInferenceBatch per game) connect
+// through a UNIX domain socket and send the flat CarState of their cars. Requests from all the clients
+// are gathered in a single batch, which is evaluated when it is full or when the
+// oldest request waited for more than the latency budget.
+// The default policy is trivial (follow the road at low speed), it is only there
+// to benchmark and test the transport without a real model.
+class InferenceServer
+{
+public:
+    struct Config
+    {
+        std::string socketPath = "/tmp/racing_inference.sock";
+        unsigned int maxBatchSize = InferenceProtocol::MAX_REQUESTS_PER_SEND;
+        unsigned int maxLatencyUs = 1000;
+        uint32_t stateSize = static_cast<uint32_t>(CarState::FLAT_SIZE);
+        uint32_t actionSize = static_cast<uint32_t>(CarAction::FLAT_SIZE);
+    };
+
+    struct Statistics
+    {
+        uint64_t nbRequests = 0;
+        uint64_t nbBatches = 0;
+        uint64_t nbFullBatches = 0;
+        unsigned int biggestBatch = 0;
+    };
+
+    // states is batchSize x stateSize, actions is batchSize x actionSize
+    using Policy = std::function<void(const float* states, size_t batchSize, float* actions)>;
+
+    InferenceServer(const Config& config, Policy policy = nullptr);
+    ~InferenceServer();
+
+    // Create and bind the socket. Must be called before Run
+    int Initialize();
+    // Serve requests until Stop is called
+    int Run();
+    // Can be called from any thread (or a signal handler)
+    void Stop() { m_stopRequested = true; }
+
+    // Only valid once Run returned
+    const Statistics& GetStatistics() const { return m_statistics; }
+
+    // Assumes the default state and action sizes
+    static void TrivialPolicy(const float* states, size_t batchSize, float* actions);
+
+private:
+    struct Client
+    {
+        int fd = -1;
+        std::vector<char> inbox;
+    };
+
+    struct PendingRequest
+    {
+        int fd;
+        uint64_t requestId;
+    };
+
+    void AcceptClient();
+    // Returns false if the client must be dropped
+    bool ReadClient(Client& client);
+    void DropClient(size_t clientIndex);
+    void FlushBatch();
+
+    Config m_config;
+    Policy m_policy;
+    Statistics m_statistics;
+    std::atomic<bool> m_stopRequested = false;
+
+    int m_listenFd = -1;
+    std::vector<Client> m_clients;
+
+    std::vector<PendingRequest> m_pendingRequests;
+    std::vector<float> m_batchStates;
+    std::vector<float> m_batchActions;
+    int64_t m_oldestPendingUs = 0;
+};
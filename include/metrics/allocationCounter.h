@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+// Heap allocations made by the calling thread, counted by replacing the
+// global operator new and delete, and the allocator of Box2D. Only compiled in with the CMake option
+// RACING_TRACK_ALLOCATIONS (opt-in, it adds a few instructions to every
+// allocation of the program). Otherwise the counts stay at 0.
+struct AllocationCounts
+{
+    uint64_t nbAllocations = 0;
+    uint64_t bytes = 0;
+    uint64_t nbFrees = 0;
+
+    void Clear() { *this = AllocationCounts(); }
+
+    // Add the allocations made between two reads
+    void AddDelta(const AllocationCounts& begin, const AllocationCounts& end)
+    {
+        nbAllocations += end.nbAllocations - begin.nbAllocations;
+        bytes += end.bytes - begin.bytes;
+        nbFrees += end.nbFrees - begin.nbFrees;
+    }
+};
+
+namespace AllocationCounter
+{
+    // True if the counting operators are compiled in
+    bool IsEnabled();
+
+    // Allocations made by the calling thread since it started
+    AllocationCounts Get();
+}
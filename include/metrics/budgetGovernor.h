@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Optional work of a frame the game loop is allowed to skip under load
+struct QualitySettings
+{
+    bool debugLines = true;
+    // Rankings are recomputed every rankingInterval frames
+    unsigned int rankingInterval = 1;
+    bool cameraSmoothing = true;
+    int velocityIterations = 0;
+    int positionIterations = 0;
+};
+
+// Degrades the quality of an interactive session when frames go over budget,
+// one level at a time, and restores it when there is headroom again:
+//   1 - no debug lines
+//   2 - rankings recomputed every RANKING_INTERVAL frames
+//   3 - no camera smoothing
+//   4+ - solver iterations halved at each level, down to a floor
+// Every change of level is logged on the standard output and kept in the
+// decisions, for the metrics summary.
+class BudgetGovernor
+{
+public:
+    struct Config
+    {
+        int64_t budgetNs = 16666666;
+        // Consecutive frames over budget to degrade
+        unsigned int overrunFrames = 2;
+        // Frames under headroom * budget to restore one level. Doubled each time
+        // a restore is quickly followed by an overrun, so the level doesn't oscillate
+        unsigned int headroomFrames = 60;
+        unsigned int maxHeadroomFrames = 1920;
+        double headroom = 0.6;
+        // Frames to wait after a change, so it can take effect
+        unsigned int cooldownFrames = 10;
+        // Solver iterations at full quality, and the floor they can be reduced to
+        int maxVelocityIterations = 8;
+        int maxPositionIterations = 3;
+        int minVelocityIterations = 8;
+        int minPositionIterations = 3;
+    };
+
+    struct Decision
+    {
+        uint64_t frame;
+        unsigned int fromLevel;
+        unsigned int toLevel;
+        // Last frame time when the decision was taken
+        int64_t frameNs;
+    };
+
+    static constexpr unsigned int RANKING_INTERVAL = 10;
+    // Only the last decisions are kept
+    static constexpr size_t MAX_DECISIONS = 1024;
+
+    BudgetGovernor() : BudgetGovernor(Config()) {}
+    BudgetGovernor(const Config& config);
+
+    void Configure(const Config& config);
+
+    // To call after each frame with the time it took (without sleeping).
+    // Returns true when the level changed.
+    bool Update(int64_t frameNs);
+
+    unsigned int GetLevel() const { return m_level; }
+    unsigned int GetMaxLevel() const { return m_maxLevel; }
+    const QualitySettings& GetSettings() const { return m_settings; }
+    const std::vector<Decision>& GetDecisions() const { return m_decisions; }
+    // All the level changes, including the ones no longer in GetDecisions
+    uint64_t GetNbLevelChanges() const { return m_nbLevelChanges; }
+    // Heap bytes of the decisions and the frames per level
+    size_t GetMemoryUsage() const { return m_decisions.capacity() * sizeof(Decision) + m_framesPerLevel.capacity() * sizeof(uint64_t); }
+
+    QualitySettings ComputeSettings(unsigned int level) const;
+    std::string DescribeLevel(unsigned int level) const;
+
+    void PrintSummary(std::ostream& stream) const;
+
+private:
+    void SetLevel(unsigned int level, int64_t frameNs);
+
+    Config m_config;
+    unsigned int m_level = 0;
+    unsigned int m_maxLevel = 0;
+    QualitySettings m_settings;
+
+    uint64_t m_nbFrames = 0;
+    unsigned int m_nbOverruns = 0;
+    unsigned int m_nbHeadroomFrames = 0;
+    unsigned int m_restoreDelay = 0;
+    unsigned int m_cooldown = 0;
+    std::vector<Decision> m_decisions;
+    uint64_t m_nbLevelChanges = 0;
+    // Number of frames spent at each level
+    std::vector<uint64_t> m_framesPerLevel;
+};
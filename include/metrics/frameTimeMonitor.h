@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <metrics/frameTimings.h>
+#include <metrics/rollingHistogram.h>
+
+// Frame time distribution of the game loop (p50, p99, p99.9, max over the
+// whole run) and attribution of the frames over budget: each overrun is
+// blamed on the part of the frame that took the longest, a step phase
+// (reset, physics, scenario and its spawns...) or the rendering.
+class FrameTimeMonitor
+{
+public:
+    // Step phases, then the parts of the frame outside GameManager::Step
+    enum Part : unsigned int
+    {
+        Part_Render = STEP_PHASE_COUNT,
+        // Whatever is not measured (frame total minus the known parts)
+        Part_Other,
+        Part_Count
+    };
+
+    FrameTimeMonitor(int64_t budgetNs = 0);
+
+    void SetBudget(int64_t budgetNs) { m_budgetNs = budgetNs; }
+    int64_t GetBudget() const { return m_budgetNs; }
+
+    // frameNs: whole frame, without the sleep. step: timings of the Step of
+    // this frame. renderNs: debug lines, inputs and rendering.
+    // Prints a line for each frame over budget.
+    void Record(int64_t frameNs, const FrameTimings& step, int64_t renderNs);
+    void Clear();
+
+    const RollingHistogram& GetFrameTimes() const { return m_frameTimes; }
+    uint64_t GetNbFrames() const { return m_nbFrames; }
+    uint64_t GetNbOverruns() const { return m_nbOverruns; }
+    uint64_t GetNbOverruns(Part part) const { return m_overrunsPerPart[part]; }
+
+    static const char* GetPartName(Part part);
+
+    void PrintSummary(std::ostream& stream) const;
+
+private:
+    int64_t m_budgetNs;
+    // In microseconds, 1us to 100s with ~1% precision
+    RollingHistogram m_frameTimes;
+    uint64_t m_nbFrames = 0;
+    uint64_t m_nbOverruns = 0;
+    std::array<uint64_t, Part_Count> m_overrunsPerPart{};
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <metrics/allocationCounter.h>
+#include <metrics/perfCounters.h>
+#include <metrics/stepPhase.h>
+
+// Wall clock time spent in each phase of one GameManager::Step, and the
+// hardware counters over the same spans when counters is set. Heap
+// allocations are counted too when built with RACING_TRACK_ALLOCATIONS.
+struct FrameTimings
+{
+    std::array<int64_t, STEP_PHASE_COUNT> phaseNs{};
+    int64_t totalNs = 0;
+    // Vehicles spawned during the step (by the scenario)
+    unsigned int nbSpawns = 0;
+
+    const PerfCounters* counters = nullptr;
+    std::array<PerfCounterValues, STEP_PHASE_COUNT> phaseCounters{};
+    PerfCounterValues totalCounters;
+
+    std::array<AllocationCounts, STEP_PHASE_COUNT> phaseAllocations{};
+    AllocationCounts totalAllocations;
+
+    void Clear()
+    {
+        phaseNs.fill(0);
+        totalNs = 0;
+        nbSpawns = 0;
+        for (PerfCounterValues& values : phaseCounters)
+            values.Clear();
+        totalCounters.Clear();
+        for (AllocationCounts& allocations : phaseAllocations)
+            allocations.Clear();
+        totalAllocations.Clear();
+    }
+
+    int64_t& operator[](StepPhase phase) { return phaseNs[static_cast<size_t>(phase)]; }
+    int64_t operator[](StepPhase phase) const { return phaseNs[static_cast<size_t>(phase)]; }
+
+    static int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+// Adds the time spent in its scope to a phase. Does nothing (no clock read)
+// when timings is null, so it can stay in the hot path. Counters cost one
+// syscall on each side of the scope, only when they are enabled.
+class PhaseScope
+{
+public:
+    PhaseScope(FrameTimings* timings, StepPhase phase)
+        : m_timings(timings)
+        , m_phase(phase)
+    {
+        if (m_timings == nullptr)
+            return;
+        if (m_timings->counters != nullptr)
+            m_timings->counters->Read(m_startCounters);
+        m_startAllocations = AllocationCounter::Get();
+        m_start = FrameTimings::NowNs();
+    }
+
+    ~PhaseScope()
+    {
+        if (m_timings == nullptr)
+            return;
+        (*m_timings)[m_phase] += FrameTimings::NowNs() - m_start;
+        m_timings->phaseAllocations[static_cast<size_t>(m_phase)].AddDelta(m_startAllocations, AllocationCounter::Get());
+        if (m_timings->counters != nullptr)
+        {
+            PerfCounterValues end;
+            m_timings->counters->Read(end);
+            m_timings->phaseCounters[static_cast<size_t>(m_phase)].AddDelta(m_startCounters, end);
+        }
+    }
+
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    FrameTimings* m_timings;
+    StepPhase m_phase;
+    int64_t m_start = 0;
+    PerfCounterValues m_startCounters;
+    AllocationCounts m_startAllocations;
+};
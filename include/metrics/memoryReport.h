@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Bytes owned by an environment, per category. Filled by the objects owning
+// the memory (AddMemoryUsage), from the capacity of their containers and the
+// allocators of Box2D, so it is the memory reserved and not only the one used.
+// Heap bookkeeping and fragmentation are not accounted: compare with the
+// resident set size of the process for the real footprint.
+class MemoryReport
+{
+public:
+    struct Entry
+    {
+        std::string name;
+        size_t bytes = 0;
+        // Number of objects accounted in the entry
+        size_t count = 0;
+    };
+
+    // Accumulates in the entry of the same name, created at the end if missing
+    void Add(const std::string& name, size_t bytes, size_t count = 1);
+    void Clear() { m_entries.clear(); }
+
+    // 0 if the entry doesn't exist
+    size_t GetBytes(const std::string& name) const;
+    size_t GetTotal() const;
+    const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+    void Print(std::ostream& stream) const;
+
+private:
+    std::vector<Entry> m_entries;
+};
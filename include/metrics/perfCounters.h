@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Hardware counters read with perf_event_open (Linux only)
+enum class PerfCounter : unsigned int
+{
+    Cycles = 0,
+    Instructions,
+    // L1 data cache read misses
+    L1DMisses,
+    // Last level cache misses
+    LLCMisses,
+    BranchMisses,
+    Count
+};
+
+constexpr size_t PERF_COUNTER_COUNT = static_cast<size_t>(PerfCounter::Count);
+
+const char* GetPerfCounterName(PerfCounter counter);
+
+struct PerfCounterValues
+{
+    std::array<uint64_t, PERF_COUNTER_COUNT> values{};
+
+    void Clear() { values.fill(0); }
+
+    uint64_t& operator[](PerfCounter counter) { return values[static_cast<size_t>(counter)]; }
+    uint64_t operator[](PerfCounter counter) const { return values[static_cast<size_t>(counter)]; }
+
+    // Add the counts between two reads
+    void AddDelta(const PerfCounterValues& begin, const PerfCounterValues& end)
+    {
+        for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i)
+            values[i] += end.values[i] - begin.values[i];
+    }
+};
+
+// One group of counters for the calling thread, user space only. All the
+// counters are read at once with a single syscall.
+// Initialize fails when perf events are not permitted (perf_event_paranoid,
+// containers without CAP_PERFMON) or not supported: callers are expected to
+// keep running without counters. Counters the CPU doesn't expose (common in
+// VMs) are left out and always read 0.
+class PerfCounters
+{
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    int Initialize();
+    void Close();
+
+    bool IsAvailable() const { return m_groupFd >= 0; }
+    bool IsAvailable(PerfCounter counter) const { return m_slots[static_cast<size_t>(counter)] >= 0; }
+
+    // Current value of each counter since Initialize
+    void Read(PerfCounterValues& out) const;
+
+private:
+    int m_groupFd = -1;
+    std::array<int, PERF_COUNTER_COUNT> m_fds;
+    // Position of each counter in the group read, -1 if not opened
+    std::array<int, PERF_COUNTER_COUNT> m_slots;
+    unsigned int m_nbOpened = 0;
+};
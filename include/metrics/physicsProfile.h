@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <metrics/rollingHistogram.h>
+
+class b2World;
+
+// Phases of b2World::Step, as measured by Box2D in b2Profile
+enum class PhysicsPhase : unsigned int
+{
+    Step = 0,
+    // Contacts update (narrow phase)
+    Collide,
+    // Islands building and solving, includes the three following phases
+    Solve,
+    SolveInit,
+    SolveVelocity,
+    SolvePosition,
+    // Synchronize fixtures and find new contacts
+    Broadphase,
+    // Continuous collisions
+    SolveTOI,
+    Count
+};
+
+constexpr size_t PHYSICS_PHASE_COUNT = static_cast<size_t>(PhysicsPhase::Count);
+
+const char* GetPhysicsPhaseName(PhysicsPhase phase);
+
+// Rolling histograms of Box2D internal profile, with the number of contacts
+// and islands of each step. Tells if the solver iterations or the broadphase
+// dominate the physics time.
+class PhysicsProfile
+{
+public:
+    // 10s at 60 fps
+    static constexpr size_t WINDOW_SIZE = 600;
+
+    PhysicsProfile(size_t windowSize = WINDOW_SIZE);
+
+    // To call after each b2World::Step
+    void Record(const b2World& world);
+    void Clear();
+
+    // In milliseconds, like b2Profile
+    const RollingHistogram& GetPhase(PhysicsPhase phase) const { return m_phases[static_cast<size_t>(phase)]; }
+    const RollingHistogram& GetContacts() const { return m_contacts; }
+    const RollingHistogram& GetIslands() const { return m_islands; }
+
+    // Heap bytes of the histograms
+    size_t GetMemoryUsage() const;
+
+private:
+    std::array<RollingHistogram, PHYSICS_PHASE_COUNT> m_phases;
+    RollingHistogram m_contacts;
+    RollingHistogram m_islands;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Histogram of the last windowSize samples. Buckets are log spaced between
+// minValue and maxValue (values outside are clamped), with subBuckets per
+// power of two: with the default 8, percentiles are within ~9% of the real
+// value whatever the magnitude, 64 gives ~1% (HDR histogram like).
+// Adding a sample is O(1), older samples leave the window as new ones come in.
+// A windowSize of 0 keeps every sample, for whole run statistics.
+class RollingHistogram
+{
+public:
+    static constexpr unsigned int DEFAULT_SUB_BUCKETS = 8;
+
+    RollingHistogram(size_t windowSize, double minValue, double maxValue, unsigned int subBuckets = DEFAULT_SUB_BUCKETS);
+
+    void Add(double value);
+    void Clear();
+
+    size_t GetCount() const { return m_count; }
+    double GetMean() const;
+    // p in [0, 1]. Returns the middle of the bucket holding the percentile
+    double GetPercentile(double p) const;
+    // Exact, not a bucket value
+    double GetMax() const { return m_count == 0 ? 0.0 : m_max; }
+
+    // Heap bytes of the buckets and the window
+    size_t GetMemoryUsage() const { return m_buckets.capacity() * sizeof(uint32_t) + m_window.capacity() * sizeof(double); }
+
+private:
+    unsigned int GetBucket(double value) const;
+    double GetBucketValue(unsigned int bucket) const;
+
+    double m_minValue;
+    unsigned int m_subBuckets;
+    std::vector<uint32_t> m_buckets;
+    // Last samples, to remove them from the buckets when they leave the window.
+    // Empty when every sample is kept
+    std::vector<double> m_window;
+    size_t m_next = 0;
+    size_t m_count = 0;
+    double m_sum = 0.0;
+    double m_max = 0.0;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+// Phases of GameManager::Step, in execution order
+enum class StepPhase : unsigned int
+{
+    Scenario = 0,
+    // CarState generation for the controllers that need it
+    Observations,
+    Controllers,
+    // Car::Step and track progress
+    CarStep,
+    // b2World::Step
+    Physics,
+    Rankings,
+    Camera,
+    // Track regenerated because a car left the playfield
+    Reset,
+    Count
+};
+
+constexpr size_t STEP_PHASE_COUNT = static_cast<size_t>(StepPhase::Count);
+
+const char* GetStepPhaseName(StepPhase phase);
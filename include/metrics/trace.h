@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Scoped zones recorded in per thread buffers and exported as a Chrome
+// trace_event JSON file (chrome://tracing, Perfetto).
+//
+//     TRACE_ZONE("b2World::Step");
+//
+// Recording is off by default: a disabled zone costs one relaxed load. Zones can
+// also be compiled out entirely with RACING_ENABLE_TRACING=OFF in CMake.
+// Zone names must outlive the trace (string literals).
+namespace Trace
+{
+    // Each thread keeps at most this number of events (reserved when the thread first
+    // records or names itself), the following ones are dropped and counted
+    constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+    inline std::atomic<bool> g_enabled{false};
+
+    inline bool IsEnabled() { return g_enabled.load(std::memory_order_relaxed); }
+    void Enable(bool enable);
+
+    // Name shown for the calling thread in the trace viewer
+    void SetThreadName(const char* name);
+
+    void RecordZone(const char* name, int64_t beginNs, int64_t endNs);
+    int64_t NowNs();
+
+    // Write every event recorded so far, on all threads, then forget them.
+    // Threads should not be recording while it runs.
+    int WriteChromeTrace(const std::string& path);
+    void Clear();
+
+    class Zone
+    {
+    public:
+        Zone(const char* name)
+            : m_name(IsEnabled() ? name : nullptr)
+        {
+            if (m_name != nullptr)
+                m_begin = NowNs();
+        }
+
+        ~Zone()
+        {
+            if (m_name != nullptr)
+                RecordZone(m_name, m_begin, NowNs());
+        }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* m_name;
+        int64_t m_begin = 0;
+    };
+}
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+#ifdef RACING_ENABLE_TRACING
+#define TRACE_ZONE(name) Trace::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#else
+#define TRACE_ZONE(name) do {} while (false)
+#endif
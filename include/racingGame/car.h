@@ -8,7 +8,6 @@
 class b2Body;
 class b2World;
 class b2RevoluteJoint;
-class Polygon;
 class CarController;
 
 class Car
@@ -28,9 +27,6 @@ public:
         float steer = 0.0f;
         float phase = 0.0f;
         float omega = 0.0f;
-
-        // Rendering
-        Polygon* polygon = nullptr;
     };
 
     struct Hull
@@ -43,9 +39,6 @@ public:
         b2Body* body = nullptr;
         glm::vec4 color;
 
-        // Rendering
-        Polygon* polygon = nullptr;
-
         // Wheels
         std::vector<Wheel> wheels;
     };
@@ -65,15 +58,12 @@ public:
     ~Car();
 
     void InitializePhysics();
-    void InitializeRendering();
     void Step(float dt);
 
     void AttachController(CarController* controller) { m_controller = controller; }
     void DetachController() { m_controller = nullptr; }
     CarController* GetController() const { return m_controller; }
 
-    void UpdateRendering();
-
     void Gas(float gas);
     void Brake(float brake);
     void Steer(float steer);
@@ -96,6 +86,9 @@ public:
     void EnableCollision(bool enable);
 
     bool GetIsReverse() const { return m_isReverse; }
+
+    // Bytes owned by the car, its Box2D bodies live in the world allocator
+    size_t GetMemoryUsage() const;
 private:
     // Not implemented yet
     //void CreateParticles(const glm::vec3& p1, const glm::vec3& p2, bool inGrass);
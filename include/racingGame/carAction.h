@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+
+class Car;
+
+// Action taken by a controller, in the same units as Car::Gas, Car::Brake and Car::Steer
+struct CarAction
+{
+    constexpr static inline size_t FLAT_SIZE = 3;
+
+    float gas = 0.0f;
+    float brake = 0.0f;
+    float steer = 0.0f;
+
+    void Apply(Car& car) const;
+
+    void Flatten(float* out) const
+    {
+        out[0] = gas;
+        out[1] = brake;
+        out[2] = steer;
+    }
+
+    static CarAction FromFlat(const float* in)
+    {
+        CarAction action;
+        action.gas = in[0];
+        action.brake = in[1];
+        action.steer = in[2];
+        return action;
+    }
+};
@@ -3,7 +3,7 @@
 #include <array>
 #include <string>
 #include <unordered_map>
-#include <set>
+#include <vector>
 #include <racingGame/track.h>
 #include <racingGame/constants.h>
 
@@ -70,6 +70,8 @@ struct CarState
 {
     constexpr static inline float MAX_SPEED = 40.0f;
     constexpr static inline float MAX_OMEGA = 40.0f;
+    // Number of floats written by Flatten. Opponents are not part of the flat state.
+    constexpr static inline size_t FLAT_SIZE = 1 + 2 + 1 + 2 + 4 + 1 + 1 + SamplingIndexes::SAMPLING_INDEXES_SIZE * 2;
 
     CarState() = default;
 
@@ -82,10 +84,17 @@ struct CarState
     float driftAngle = 0.0f;
     std::array<float, SamplingIndexes::SAMPLING_INDEXES_SIZE*2> pointsFurther;
     std::array<float, SamplingIndexes::SAMPLING_INDEXES_SIZE> debugPointsFurtherDistances;
-    std::multiset<OpponentCar> opponentsOrdered;
+    // Sorted by distance
+    std::vector<OpponentCar> opponentsOrdered;
 
     static CarState GenerateState(const Car& car, const Track::Path& path, unsigned int currentIndex, 
         bool addDebugInfo, unsigned int carId, const std::unordered_map<unsigned int, Car*>& allCars);
+    // Same, reusing the opponents buffer of outState: no allocation once it is big enough
+    static void GenerateState(const Car& car, const Track::Path& path, unsigned int currentIndex,
+        bool addDebugInfo, unsigned int carId, const std::unordered_map<unsigned int, Car*>& allCars, CarState& outState);
+
+    // Write the state in the order described at the top of this file
+    void Flatten(float* out) const;
 
     std::string ToString();
 };
\ No newline at end of file
@@ -103,4 +103,8 @@ namespace Constants
 
     // How many frames between state computation (and action taken by the network)
     constexpr unsigned int STATE_INTERVAL = 5;
+
+    // Box2D solver iterations per frame
+    constexpr int VELOCITY_ITERATIONS = 6 * 30;
+    constexpr int POSITION_ITERATIONS = 2 * 30;
 };
\ No newline at end of file
@@ -12,10 +12,15 @@ public:
 
     }
 
+    virtual ~CarController() = default;
+
     unsigned int GetStateInterval() { return m_stateInterval; }
 
     // Will be called only each m_stateInterval frames
     virtual void Update(const CarState& state, Car& car) = 0;
+
+    // If false, the state given to Update is left empty (saves its computation)
+    virtual bool RequiresState() const { return true; }
 protected:
     unsigned int m_stateInterval;
 };
\ No newline at end of file
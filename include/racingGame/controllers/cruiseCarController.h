@@ -0,0 +1,14 @@
+#pragma once
+
+#include <racingGame/controllers/carController.h>
+
+// Scripted driver for benchmarks and checks: holds a cruise speed and steers
+// toward a point of the road ahead given by the observation, like a trained
+// policy would. Stateless, one instance can drive all the cars.
+class CruiseCarController : public CarController
+{
+public:
+    CruiseCarController();
+
+    virtual void Update(const CarState& state, Car& car) override;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <racingGame/controllers/carController.h>
+#include <racingGame/carAction.h>
+
+// Controller driven from outside the game loop (training environments).
+// The owner sets the action, which is applied every frame. No state is generated,
+// the owner computes the observations itself when it needs them.
+class ExternalCarController : public CarController
+{
+public:
+    ExternalCarController() : CarController(1) {}
+
+    virtual void Update(const CarState& state, Car& car) override;
+    virtual bool RequiresState() const override { return false; }
+
+    void SetAction(const CarAction& action) { m_action = action; }
+    const CarAction& GetAction() const { return m_action; }
+
+protected:
+    CarAction m_action;
+};
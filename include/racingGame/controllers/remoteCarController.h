@@ -0,0 +1,44 @@
+#pragma once
+
+#include <racingGame/controllers/carController.h>
+#include <inference/inferenceClient.h>
+#include <string>
+#include <vector>
+
+// Requests of all the RemoteCarControllers of a game, on one connection to a local
+// inference server (see InferenceServer). The controllers queue their state, Flush
+// sends them together and applies the actions: one round trip, and one batching
+// window of the server, per frame and per 64 cars instead of one per car.
+class RemoteInferenceBatch
+{
+public:
+    RemoteInferenceBatch(const std::string& socketPath);
+
+    void Queue(const CarState& state, Car& car);
+    // If the server can't be reached, the cars keep their previous action
+    void Flush();
+
+    bool IsConnected() const { return m_client.IsConnected(); }
+
+private:
+    InferenceClient m_client;
+    // Reused between frames
+    std::vector<Car*> m_cars;
+    std::vector<float> m_states;
+    std::vector<float> m_actions;
+};
+
+// Controller asking a local inference server for its actions, through the batch of
+// its game. The action is applied when the batch is flushed, before the car steps.
+class RemoteCarController : public CarController
+{
+public:
+    RemoteCarController(unsigned int stateInterval, RemoteInferenceBatch& batch);
+
+    virtual void Update(const CarState& state, Car& car) override;
+
+    bool IsConnected() const { return m_batch.IsConnected(); }
+
+protected:
+    RemoteInferenceBatch& m_batch;
+};
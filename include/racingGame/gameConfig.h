@@ -13,6 +13,13 @@ struct GameConfig
     bool attachCamera = true;
     bool debugInfo = false;
     bool computeRankings = true;
+    // When rendering, skip optional work (debug lines, rankings, camera smoothing,
+    // solver iterations) while frames are over budget. See BudgetGovernor
+    bool adaptiveQuality = true;
+    // When rendering, simulate on a worker thread while the calling thread draws the latest
+    // frame (see PipelinedGameView): the simulation no longer waits for vsync or the driver.
+    // Not with human play, the input is read on the simulation thread
+    bool renderThread = false;
 
     float GetDt() const { return 1.0f / fps; }
 };
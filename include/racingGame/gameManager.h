@@ -1,55 +1,116 @@
 #pragma once
 
+#include <memory>
 #include <vector>
+#include <mutex>
 #include <unordered_map>
 #include <utils/utils.h>
 #include <racingGame/car.h>
+#include <racingGame/carState.h>
 #include <racingGame/gameConfig.h>
+#include <metrics/budgetGovernor.h>
+#include <metrics/frameTimeMonitor.h>
+#include <metrics/frameTimings.h>
+#include <metrics/memoryReport.h>
+#include <metrics/physicsProfile.h>
 
 class b2World;
 class Track;
 class Scenario;
+class GameView;
 
 class GameManager
 {
 public:
-    GameManager(const GameConfig& config, Scenario* scenario);
+    // view can be null, the game then runs headless
+    GameManager(const GameConfig& config, Scenario* scenario, GameView* view = nullptr);
     ~GameManager();
 
     void SetNumberOfPlayers(unsigned int numberOfPlayers) {m_numberOfPlayers = numberOfPlayers;}
     void SpawnVehicle(unsigned int trackIndex = 0, bool reverse = false, float offset = 0.0f);
     void UnspawnVehicle(unsigned int id);
 
+    // Everything Run does before entering the game loop. Can be used instead of Run
+    // to drive the game from outside (training environments), calling Step manually.
+    int Setup();
     int Run();
     void Reset();
+    void Step(float dt);
 
     const Track* GetTrack() const { return m_track; }
+    b2World* GetWorld() { return m_world; }
+    const b2World* GetWorld() const { return m_world; }
     const std::vector<const Car*>& GetRanking() const { return m_raceRanking; }
+    const std::unordered_map<unsigned int, Car*>& GetCars() const { return m_cars; }
     const Car::LapInfo* GetLapInfoFromId(unsigned int id) const;
     void GetCarsIndexOnTrack(std::vector<unsigned int>& outVector) const;
     void UpdateCarsRanking();
 
     float GetElapsedTime() const;
 
+    // Time spent in each phase of the last Step. Only measured when enabled
+    void EnableFrameTimings(bool enable) { m_frameTimingsEnabled = enable; }
+    const FrameTimings& GetFrameTimings() const { return m_frameTimings; }
+    // Also read the hardware counters around each phase of the frame timings.
+    // Counters follow the calling thread, Step must be called from the same one.
+    // Fails (and timings keep running without them) when perf events are not permitted.
+    int EnablePerfCounters(bool enable);
+    // Box2D internal breakdown of the last steps, recorded with the frame timings
+    const PhysicsProfile& GetPhysicsProfile() const { return m_physicsProfile; }
+    // Frame times of Run when rendering, with the frames over budget
+    const FrameTimeMonitor& GetFrameTimeMonitor() const { return m_frameTimeMonitor; }
+    const BudgetGovernor& GetBudgetGovernor() const { return m_budgetGovernor; }
+
+    // Add the memory owned by the game: Box2D world, cars, track and view
+    void AddMemoryUsage(MemoryReport& report) const;
+
 private:
     int Initialize();
 
-    void Step(float dt);
-
     void ClearCars();
+    // Record the frame, adapt the quality and sleep for the rest of the frame budget.
+    // frameNs is the time to show the frame, simulationNs the time spent by this thread
+    void EndFrame(int64_t frameNs, int64_t simulationNs, int64_t renderNs, int64_t frameBudgetNs, bool adaptiveQuality);
+    void RunPipelined(int64_t frameBudgetNs, bool adaptiveQuality);
     void UpdateCamera();
+    void ApplyQualitySettings(const QualitySettings& settings);
 
     void CreateSingletons();
     void DestroySingletons();
 
     b2World* m_world = nullptr;
-    Track* m_track;
+    Track* m_track = nullptr;
     std::unordered_map<unsigned int, Car*> m_cars;
     std::vector<const Car*> m_raceRanking;
     unsigned int m_numberOfPlayers = 0;
     Utils::RingBuffer<float, 5> m_smoothCameraRotation;
+    // Controllers to update this frame, with the state of their car. Reused between frames,
+    // the states keep their buffers
+    struct DueController
+    {
+        Car* car;
+        CarController* controller;
+        unsigned int carIndex;
+    };
+    std::vector<DueController> m_dueControllers;
+    std::vector<CarState> m_carStates;
 
     unsigned int m_nbFrames = 0;
     GameConfig m_initialGameConfig;
     Scenario* m_scenario = nullptr;
+    GameView* m_view = nullptr;
+
+    bool m_frameTimingsEnabled = false;
+    FrameTimings m_frameTimings;
+    std::unique_ptr<PerfCounters> m_perfCounters;
+    PhysicsProfile m_physicsProfile;
+    FrameTimeMonitor m_frameTimeMonitor;
+    BudgetGovernor m_budgetGovernor;
+    // Lowered by the budget governor, always full quality when headless
+    QualitySettings m_quality;
+
+    // Singletons are shared between all the game managers alive (environment pools)
+    bool m_holdsSingletons = false;
+    static inline unsigned int ms_nbSingletonsUsers = 0;
+    static inline std::mutex ms_singletonsLock;
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+struct GameConfig;
+class Car;
+class GameManager;
+class MemoryReport;
+struct SceneSnapshot;
+class Track;
+
+// Presentation layer of a game. The core (physics, cars, track, scenarios) never
+// talks to a window or to OpenGL, it only notifies its view. A GameManager without
+// view runs headless, the renderer provides RendererGameView.
+class GameView
+{
+public:
+    virtual ~GameView() = default;
+
+    virtual int Initialize(const GameConfig& config) = 0;
+    virtual void Close() {}
+
+    virtual bool IsEnabled() const = 0;
+    virtual bool IsPaused() const { return false; }
+    virtual bool RequestedClose() { return false; }
+
+    virtual void ProcessInput() {}
+    virtual void Render(const GameManager&) {}
+    // Draw a frame captured on the simulation thread, from the thread owning the view.
+    // See PipelinedGameView, the track and the camera come with the snapshot
+    virtual bool SupportsSnapshots() const { return false; }
+    virtual void Render(const SceneSnapshot&) {}
+
+    // Follow a car, angle is already smoothed by the game
+    virtual void UpdateCamera(const glm::vec2&, float) {}
+
+    // Called before the cars and the track are destroyed
+    virtual void OnReset() {}
+    virtual void OnTrackGenerated(const Track&) {}
+    virtual void OnVehicleSpawned(const Car&) {}
+    virtual void OnVehicleUnspawned(const Car&) {}
+
+    // Add the memory owned by the view (GPU buffers included)
+    virtual void AddMemoryUsage(MemoryReport&) const {}
+};
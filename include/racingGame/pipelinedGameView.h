@@ -0,0 +1,65 @@
+#pragma once
+
+#include <racingGame/gameView.h>
+#include <racingGame/sceneSnapshot.h>
+#include <utils/tripleBuffer.h>
+
+#include <atomic>
+#include <memory>
+
+// Puts a view on another thread than the simulation. The game talks to this
+// view on the simulation thread: Render captures a snapshot of the frame and
+// publishes it, track and camera events are recorded in the next snapshot.
+// The thread owning the target view (its GL context) calls RenderLatest, which
+// draws the newest snapshot and never waits for the simulation, nor the
+// simulation for it. The target must support snapshots.
+class PipelinedGameView : public GameView
+{
+public:
+    // target stays owned by the caller
+    PipelinedGameView(GameView* target);
+
+    // Forwarded to the target, call them on its thread
+    virtual int Initialize(const GameConfig& config) override { return m_target->Initialize(config); }
+    virtual void Close() override { m_target->Close(); }
+
+    // Simulation thread
+    virtual bool IsEnabled() const override { return m_target->IsEnabled(); }
+    virtual bool IsPaused() const override { return m_paused.load(std::memory_order_relaxed); }
+    virtual bool RequestedClose() override { return m_closeRequested.load(std::memory_order_relaxed); }
+    using GameView::Render;
+    virtual void Render(const GameManager& game) override;
+    virtual void UpdateCamera(const glm::vec2& position, float angle) override;
+    virtual void OnReset() override;
+    virtual void OnTrackGenerated(const Track& track) override;
+    virtual void AddMemoryUsage(MemoryReport& report) const override;
+
+    // Target thread. Process the input of the target, then draw the newest snapshot if any was
+    // published since the last call. Returns whether one was drawn
+    bool RenderLatest();
+    // Stop the simulation, from any thread
+    void RequestClose() { m_closeRequested.store(true, std::memory_order_relaxed); }
+
+    uint64_t GetNbPublished() const { return m_nbPublished; }
+    uint64_t GetNbRendered() const { return m_nbRendered; }
+    // Time the target took to draw the last snapshot, from any thread
+    int64_t GetLastRenderNs() const { return m_lastRenderNs.load(std::memory_order_relaxed); }
+
+private:
+    GameView* m_target;
+    TripleBuffer<SceneSnapshot> m_snapshots;
+
+    // Recorded on the simulation thread, copied in each published snapshot
+    bool m_hasCamera = false;
+    glm::vec2 m_cameraPosition = glm::vec2(0.0f);
+    float m_cameraAngle = 0.0f;
+    uint64_t m_trackVersion = 0;
+    std::shared_ptr<const SceneSnapshot::TrackShape> m_track;
+    uint64_t m_nbPublished = 0;
+
+    // Written by the target thread
+    std::atomic<bool> m_paused = false;
+    std::atomic<bool> m_closeRequested = false;
+    uint64_t m_nbRendered = 0;
+    std::atomic<int64_t> m_lastRenderNs = 0;
+};
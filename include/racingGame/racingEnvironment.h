@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <racingGame/carAction.h>
+#include <racingGame/carState.h>
+#include <racingGame/constants.h>
+#include <racingGame/gameManager.h>
+#include <racingGame/scenarios/trainingScenario.h>
+#include <rasterizer/lidar.h>
+#include <rasterizer/occupancyGrid.h>
+#include <rasterizer/softwareRasterizer.h>
+
+// Headless race driven step by step from outside, for reinforcement learning.
+// All the cars of the race are agents: actions and observations are given for
+// every car, in the order of their slot in the TrainingScenario.
+// Rewards follow CarRacing: +1000/N for each track tile gained, -0.1 per frame,
+// -100 when a car leaves the playfield (which ends the episode).
+class RacingEnvironment
+{
+public:
+    // CarState part of an observation, see GetObservationSize
+    constexpr static inline size_t OBSERVATION_SIZE = CarState::FLAT_SIZE;
+    constexpr static inline size_t ACTION_SIZE = CarAction::FLAT_SIZE;
+
+    struct Config
+    {
+        unsigned int nbCars = 1;
+        unsigned int seed = 0;
+        // Number of frames simulated for each Step (actions are held)
+        unsigned int frameSkip = Constants::STATE_INTERVAL;
+        // 0 means no limit
+        unsigned int maxEpisodeSteps = 1000;
+        SpawningStrategy::Strategy spawningStrategy = SpawningStrategy::Strategy_Formula1;
+        // Also render a top-down RGB frame for each car (see SoftwareRasterizer)
+        bool pixelObservations = false;
+        SoftwareRasterizer::Config rasterizer;
+        // Append an OccupancyGrid around the car to its observation, after the CarState
+        bool occupancyGrid = false;
+        OccupancyGrid::Config grid;
+        // Append Lidar distances to the observation, after the grid
+        bool lidarObservations = false;
+        Lidar::Config lidar;
+    };
+
+    // Floats of the observation of a car
+    static size_t GetObservationSize(const Config& config)
+    {
+        return OBSERVATION_SIZE + (config.occupancyGrid ? OccupancyGrid::GetSize(config.grid) : 0) +
+            (config.lidarObservations ? Lidar::GetSize(config.lidar) : 0);
+    }
+
+    RacingEnvironment(const Config& config);
+
+    int Initialize();
+    // Start a new episode on a new track
+    void Reset();
+    // actions is nbCars x ACTION_SIZE
+    void Step(const float* actions);
+
+    unsigned int GetNbCars() const { return m_config.nbCars; }
+    size_t GetObservationSize() const { return GetObservationSize(m_config); }
+    // nbCars x GetObservationSize()
+    const float* GetObservations() const { return m_observations.data(); }
+    // nbCars
+    const float* GetRewards() const { return m_rewards.data(); }
+    // nbCars x GetPixelObservationSize() bytes, empty without pixel observations
+    const uint8_t* GetPixels() const { return m_pixels.data(); }
+    size_t GetPixelObservationSize() const { return m_config.pixelObservations ? m_rasterizer.GetFrameSize() : 0; }
+    bool IsDone() const { return m_done; }
+    unsigned int GetEpisodeStep() const { return m_episodeStep; }
+
+    const GameManager& GetGameManager() const { return m_gameManager; }
+    // Car of a slot, nullptr once the episode ended out of the playfield
+    const Car* GetCar(unsigned int carIndex) const { return m_scenario.GetCar(carIndex); }
+
+    // Memory owned by the environment, game included
+    void AddMemoryUsage(MemoryReport& report) const;
+
+private:
+    void ComputeObservations();
+    void RenderPixels();
+    int GetProgress(unsigned int carIndex) const;
+
+    Config m_config;
+    std::default_random_engine m_generator;
+    TrainingScenario m_scenario;
+    GameManager m_gameManager;
+
+    std::vector<float> m_observations;
+    std::vector<float> m_rewards;
+    std::vector<int> m_progress;
+    // Reused for every car, keeps its buffers between steps
+    CarState m_state;
+    OccupancyGrid m_occupancyGrid;
+    Lidar m_lidar;
+    SoftwareRasterizer m_rasterizer;
+    std::vector<uint8_t> m_pixels;
+    std::vector<const Car*> m_pixelCars;
+    bool m_done = true;
+    // Set when the game manager already generated a new track (car out of the playfield)
+    bool m_trackIsFresh = false;
+    unsigned int m_episodeStep = 0;
+};
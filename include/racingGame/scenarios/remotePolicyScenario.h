@@ -0,0 +1,25 @@
+#pragma once
+
+#include <racingGame/scenarios/scenario.h>
+#include <racingGame/controllers/remoteCarController.h>
+#include <string>
+#include <unordered_map>
+
+// All the cars are driven by a policy served by a local InferenceServer, their
+// requests of a frame are sent together
+class RemotePolicyScenario : public Scenario
+{
+public:
+    RemotePolicyScenario(unsigned int nbCars, const std::string& socketPath);
+
+    virtual void Update(GameManager& manager) override;
+    virtual void OnVehicleSpawned(Car* car) override;
+    virtual void OnVehicleUnspawned(Car* car) override;
+    virtual void OnControllersUpdated() override;
+private:
+    using MapIdControllers = std::unordered_map<unsigned int, RemoteCarController*>;
+    MapIdControllers m_controllers;
+
+    unsigned int m_nbCars = 0;
+    RemoteInferenceBatch m_batch;
+};
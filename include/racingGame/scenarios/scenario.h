@@ -6,9 +6,14 @@ class GameManager;
 class Scenario
 {
 public:
+    virtual ~Scenario() = default;
+
     // Function called at the beginning of each frame.
     virtual int Initialize() { return 0; }
     virtual void Update(GameManager&) {}
     virtual void OnVehicleSpawned(Car*) {}
     virtual void OnVehicleUnspawned(Car*) {}
+    // Called once all the controllers of the frame were updated, before the cars are stepped.
+    // Controllers gathering their requests apply the actions here
+    virtual void OnControllersUpdated() {}
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 class GameManager;
 
 class SpawningStrategy
@@ -13,15 +15,30 @@ public:
         Strategy_Formula1 = 3
     };
 
+    // Where the next vehicle spawns, per thread
+    struct ThreadState
+    {
+        unsigned int currentTrackIndex;
+        float currentOffset;
+        bool firstCall;
+    };
+
     static void SpawnVehicle(::GameManager& gameManager, const Strategy& strategy);
     static void ResetInternalVariables();
+
+    // To move a game to another thread
+    static ThreadState GetThreadState();
+    static void SetThreadState(const ThreadState& state);
 private:
     static void AllOnStartStrategy(::GameManager& gameManager);
     static void RandomStrategy(::GameManager& gameManager);
     static void SpacedStrategy(::GameManager& gameManager);
     static void Formula1Strategy(::GameManager& gameManager);
 
-    inline static unsigned int m_currentTrackIndex = 0;
-    inline static float m_currentOffset = 1.0f;
-    inline static bool m_firstCall = true;
+    // Per thread, as several games can spawn vehicles at the same time (environment pools)
+    inline static thread_local unsigned int m_currentTrackIndex = 0;
+    inline static thread_local float m_currentOffset = 1.0f;
+    inline static thread_local bool m_firstCall = true;
+    // Reused between spawns
+    inline static thread_local std::vector<unsigned int> m_trackIndexes;
 };
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <racingGame/scenarios/scenario.h>
+#include <racingGame/scenarios/spawningStrategy.h>
+#include <racingGame/controllers/externalCarController.h>
+#include <cstdint>
+#include <vector>
+
+// Fixed number of cars, all driven by ExternalCarControllers.
+// Each car keeps the same slot (index) for the whole episode.
+class TrainingScenario : public Scenario
+{
+public:
+    TrainingScenario(unsigned int nbCars, SpawningStrategy::Strategy strategy);
+
+    virtual void Update(GameManager& manager) override;
+    virtual void OnVehicleSpawned(Car* car) override;
+    virtual void OnVehicleUnspawned(Car* car) override;
+
+    unsigned int GetNbCars() const { return static_cast<unsigned int>(m_cars.size()); }
+    // nullptr if the slot is empty
+    Car* GetCar(unsigned int index) const { return m_cars[index]; }
+    ExternalCarController& GetController(unsigned int index) { return m_controllers[index]; }
+
+    bool IsComplete() const { return m_nbSpawnedCars == m_cars.size(); }
+    // Incremented each time a car is removed. Used to detect a reset done by the game manager
+    uint64_t GetNbUnspawns() const { return m_nbUnspawns; }
+
+private:
+    std::vector<ExternalCarController> m_controllers;
+    std::vector<Car*> m_cars;
+    unsigned int m_nbSpawnedCars = 0;
+    uint64_t m_nbUnspawns = 0;
+    SpawningStrategy::Strategy m_strategy;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <debugManager/debugManager.h>
+#include <racingGame/track.h>
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class GameManager;
+
+// Everything needed to draw a frame, copied out of the game so it can be drawn
+// by another thread while the simulation goes on (see PipelinedGameView).
+struct SceneSnapshot
+{
+    struct CarInstance
+    {
+        glm::vec2 position;
+        float angle;
+        glm::vec4 color;
+        // Relative to the hull
+        float wheelAngles[4];
+        unsigned int nbWheels;
+    };
+
+    // Road of a track, shared by the snapshots until the next one is generated
+    struct TrackShape
+    {
+        Track::Path path;
+        std::vector<float> betas;
+        std::vector<bool> borders;
+    };
+
+    uint64_t frame = 0;
+    std::vector<CarInstance> cars;
+    std::vector<DebugManager::DebugLine> debugLines;
+
+    // Camera following a car, when attached
+    bool hasCamera = false;
+    glm::vec2 cameraPosition = glm::vec2(0.0f);
+    float cameraAngle = 0.0f;
+
+    // Changed each time the track is generated or cleared, 0 until the first change.
+    // Null track when cleared
+    uint64_t trackVersion = 0;
+    std::shared_ptr<const TrackShape> track;
+
+    // Cars and debug lines of the current frame, the rest is left as is. Reuses the buffers
+    void Capture(const GameManager& game);
+    size_t GetMemoryUsage() const;
+};
@@ -5,34 +5,36 @@
 #include <vector>
 #include <glm/glm.hpp>
 
-class Polygon;
-
 class Track
 {
 public:
     using Path = std::vector<glm::vec2>;
     
-    Track();
+    Track() = default;
 
     ~Track()
     {
         ClearTrack();
-        ClearBackground();
     }
     
     bool GenerateTrack();
     void ClearTrack();
-    void ClearBackground();
     const Path& GetPath() const {return m_path;}
+    // Road direction at each point of the path, the road is extruded orthogonally to it
+    const std::vector<float>& GetBetas() const {return m_betas;}
+    // Whether each tile of the path has a border (sharp turns)
+    const std::vector<bool>& GetBorders() const {return m_borders;}
     float GetIntialAngle() const {return m_initialAngle;}
     float GetAngle(size_t index, bool reverse) const;
 
     unsigned int GetLength() const { return static_cast<unsigned int>(m_path.size()); }
 
+    // Bytes owned by the track (path, directions and borders)
+    size_t GetMemoryUsage() const;
+
 private:
-    std::vector<Polygon*> m_backgroundSquares;
-    Polygon* m_tilesPolygon = nullptr;
-    std::vector<Polygon*> m_bordersPolygon;
     Path m_path;
+    std::vector<float> m_betas;
+    std::vector<bool> m_borders;
     float m_initialAngle = 0.0f;
 };
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Car;
+class Track;
+
+// Range finder observation: rays fanned from a car, returning the distance to
+// the edge of the road and to the other cars (their footprint, as a box).
+// Much cheaper than b2World::RayCast per ray: the edges of the road are
+// bucketed once per track in a uniform grid, each car gathers the edges in its
+// range, and the rays are traced four at a time against them with SSE2.
+class Lidar
+{
+public:
+    struct Config
+    {
+        unsigned int nbRays = 32;
+        // Spread of the rays around the heading of the car (radians), 2 pi for all around
+        float fov = 6.2831853f;
+        float maxRange = 50.0f;
+        // Cells of the edges acceleration grid, in meters
+        float cellSize = 10.0f;
+    };
+
+    Lidar() : Lidar(Config()) {}
+    Lidar(const Config& config);
+
+    void Configure(const Config& config);
+    const Config& GetConfig() const { return m_config; }
+    // Floats written by Compute: distances to the road edges for each ray, then
+    // distances to the cars. Divided by maxRange, 1 when nothing is in range
+    size_t GetSize() const { return GetSize(m_config); }
+    static size_t GetSize(const Config& config) { return 2 * static_cast<size_t>(config.nbRays); }
+
+    // To call each time a new track is generated
+    void SetTrack(const Track& track);
+
+    void Compute(const Car& egoCar, const std::unordered_map<unsigned int, Car*>& cars, float* out);
+
+    size_t GetMemoryUsage() const;
+
+private:
+    // Segments p + s * e, s in [0, 1], structure of arrays
+    struct Segments
+    {
+        std::vector<float> px;
+        std::vector<float> py;
+        std::vector<float> ex;
+        std::vector<float> ey;
+
+        void Clear();
+        void Add(const glm::vec2& p1, const glm::vec2& p2);
+        size_t GetSize() const { return px.size(); }
+        size_t GetMemoryUsage() const { return 4 * px.capacity() * sizeof(float); }
+    };
+
+    // Closest hit of each ray against the segments of indexes (all of them when null),
+    // in meters (maxRange when none)
+    void Trace(const glm::vec2& origin, const Segments& segments, const uint32_t* indexes, size_t nbSegments, float* distances) const;
+
+    Config m_config;
+    // Direction of each ray in the car frame, padded to a multiple of 4 rays
+    std::vector<float> m_localDirectionsX;
+    std::vector<float> m_localDirectionsY;
+    // Rotated with the car, for the current trace
+    std::vector<float> m_directionsX;
+    std::vector<float> m_directionsY;
+
+    // Road edges, and the edges of each cell of the grid (cell i: m_cellEdges[m_cellStarts[i], m_cellStarts[i + 1]))
+    Segments m_edges;
+    glm::vec2 m_gridOrigin = glm::vec2(0.0f);
+    int m_gridWidth = 0;
+    int m_gridHeight = 0;
+    std::vector<uint32_t> m_cellStarts;
+    std::vector<uint32_t> m_cellEdges;
+    // Last query that gathered each edge, so an edge in several cells is traced once
+    std::vector<uint32_t> m_edgeStamps;
+    uint32_t m_stamp = 0;
+
+    // Per query
+    std::vector<uint32_t> m_candidates;
+    Segments m_carSides;
+    std::vector<float> m_distances;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <rasterizer/rasterGeometry.h>
+
+class Car;
+class Track;
+
+// Small bird's-eye grid around a car, aligned with its heading (row 0 is ahead),
+// with one channel per kind of surface. Much cheaper than full frames
+// (SoftwareRasterizer): only the track tiles and the footprints of the cars
+// near the car are rasterized, at one sample per cell (its center).
+class OccupancyGrid
+{
+public:
+    enum Channel
+    {
+        // 1 on the road, 0 on the grass (or outside of the playfield)
+        Channel_Road = 0,
+        Channel_Border,
+        // Other cars, the car itself is not marked
+        Channel_Cars,
+        Channel_Count
+    };
+
+    struct Config
+    {
+        // Cells per side
+        unsigned int size = 16;
+        float cellSize = 2.0f;
+        // Position of the car from the top of the grid, in fraction of the size
+        float carPositionY = 0.75f;
+    };
+
+    OccupancyGrid() : OccupancyGrid(Config()) {}
+    OccupancyGrid(const Config& config);
+
+    void Configure(const Config& config);
+    const Config& GetConfig() const { return m_config; }
+    // Floats of one grid: Channel_Count x size x size, channel major
+    size_t GetSize() const { return GetSize(m_config); }
+    static size_t GetSize(const Config& config) { return Channel_Count * static_cast<size_t>(config.size) * config.size; }
+
+    // To call each time a new track is generated
+    void SetTrack(const Track& track);
+
+    // Writes GetSize() floats, 0 or 1
+    void Compute(const Car& egoCar, const std::unordered_map<unsigned int, Car*>& cars, float* out);
+
+    size_t GetMemoryUsage() const;
+
+private:
+    struct Quad
+    {
+        glm::vec2 p[4];
+        RasterGeometry::Bounds bounds;
+        uint8_t mask;
+    };
+
+    void FillQuad(const RasterGeometry::EgoView& view, const glm::vec2 (&corners)[4], uint8_t mask);
+
+    Config m_config;
+    // Road and border tiles
+    std::vector<Quad> m_trackQuads;
+    // One bit per channel for each cell
+    std::vector<uint8_t> m_cells;
+};
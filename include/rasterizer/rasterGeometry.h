@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+class Car;
+class Track;
+
+// Helpers shared by the CPU renderers of the observations (SoftwareRasterizer,
+// OccupancyGrid, Lidar): views centered on a car, track tiles and triangle filling.
+namespace RasterGeometry
+{
+    // Axis aligned, in world space
+    struct Bounds
+    {
+        glm::vec2 min;
+        glm::vec2 max;
+
+        bool Overlaps(const Bounds& other) const
+        {
+            return max.x >= other.min.x && min.x <= other.max.x && max.y >= other.min.y && min.y <= other.max.y;
+        }
+    };
+
+    inline Bounds GetBounds(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c)
+    {
+        return { glm::min(glm::min(a, b), c), glm::max(glm::max(a, b), c) };
+    }
+
+    inline Bounds GetBounds(const glm::vec2 (&corners)[4])
+    {
+        Bounds bounds = GetBounds(corners[0], corners[1], corners[2]);
+        bounds.min = glm::min(bounds.min, corners[3]);
+        bounds.max = glm::max(bounds.max, corners[3]);
+        return bounds;
+    }
+
+    // World to a grid of width x height cells centered on a car and turned with it,
+    // the car facing up (rows go down). The car is at positionY x height from the top.
+    class EgoView
+    {
+    public:
+        EgoView(const glm::vec2& center, float angle, float cellSize, unsigned int width, unsigned int height, float positionY)
+            : m_center(center)
+            , m_cos(std::cos(-angle) / cellSize)
+            , m_sin(std::sin(-angle) / cellSize)
+            , m_origin(0.5f * width, positionY * height)
+        {
+            // Whatever the rotation, the grid is in this square around the car
+            const float halfWidth = 0.5f * width;
+            const float halfHeight = std::max(positionY, 1.0f - positionY) * height;
+            m_radius = std::sqrt(halfWidth * halfWidth + halfHeight * halfHeight) * cellSize;
+        }
+
+        glm::vec2 ToGrid(const glm::vec2& p) const
+        {
+            const glm::vec2 d = p - m_center;
+            return glm::vec2(m_origin.x + m_cos * d.x - m_sin * d.y, m_origin.y - (m_sin * d.x + m_cos * d.y));
+        }
+
+        float GetRadius() const { return m_radius; }
+        Bounds GetBounds() const { return { m_center - glm::vec2(m_radius), m_center + glm::vec2(m_radius) }; }
+
+    private:
+        glm::vec2 m_center;
+        float m_cos;
+        float m_sin;
+        glm::vec2 m_origin;
+        float m_radius = 0.0f;
+    };
+
+    // Corners of the road tile starting at path point i, in the order of the
+    // vertex buffers of RendererGameView (two triangles: 0 1 2 and 1 2 3)
+    void GetRoadQuad(const Track& track, size_t i, glm::vec2 (&corners)[4]);
+    // Same for the border of the tile, false if the tile has none
+    bool GetBorderQuad(const Track& track, size_t i, glm::vec2 (&corners)[4]);
+
+    // Box around the hull of the car (see Constants::HULL_VERTICES): front left,
+    // front right, back left, back right, so the same triangles as the tiles
+    void GetCarQuad(const Car& car, glm::vec2 (&corners)[4]);
+    // Distance from the center of a car to the farthest corner of its box
+    float GetCarRadius();
+
+    // Calls fillSpan(y, x0, x1) for each row of the width x height grid, with the
+    // cells [x0, x1) whose center is inside the triangle. Spans are never empty.
+    template<typename FillSpan>
+    void RasterizeTriangle(glm::vec2 a, glm::vec2 b, glm::vec2 c, int width, int height, FillSpan&& fillSpan)
+    {
+        // Sorted by y, top first
+        if (b.y < a.y)
+            std::swap(a, b);
+        if (c.y < a.y)
+            std::swap(a, c);
+        if (c.y < b.y)
+            std::swap(b, c);
+
+        const int yBegin = std::max(static_cast<int>(std::ceil(a.y - 0.5f)), 0);
+        const int yEnd = std::min(static_cast<int>(std::ceil(c.y - 0.5f)), height);
+        if (yBegin >= yEnd)
+            return;
+
+        // Only used for the rows crossing them, so never divided by 0
+        const float slopeAC = (c.x - a.x) / (c.y - a.y);
+        const float slopeAB = b.y > a.y ? (b.x - a.x) / (b.y - a.y) : 0.0f;
+        const float slopeBC = c.y > b.y ? (c.x - b.x) / (c.y - b.y) : 0.0f;
+        for (int y = yBegin; y < yEnd; ++y)
+        {
+            const float centerY = y + 0.5f;
+            const float xAC = a.x + (centerY - a.y) * slopeAC;
+            const float xOther = centerY < b.y ? a.x + (centerY - a.y) * slopeAB : b.x + (centerY - b.y) * slopeBC;
+            const int x0 = std::max(static_cast<int>(std::ceil(std::min(xAC, xOther) - 0.5f)), 0);
+            const int x1 = std::min(static_cast<int>(std::ceil(std::max(xAC, xOther) - 0.5f)), width);
+            if (x0 < x1)
+                fillSpan(y, x0, x1);
+        }
+    }
+}
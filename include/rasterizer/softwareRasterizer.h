@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include <rasterizer/rasterGeometry.h>
+
+class Car;
+class Track;
+
+// Top-down frames of the race rendered on the CPU, for pixel observations on
+// nodes without GPU (like the 96x96 RGB frames of CarRacing). Each frame is
+// centered on a car and turns with it, the car facing up. The track is
+// converted once into colored triangles (grass, road tiles and borders, with
+// the colors of RendererGameView), the cars are added at each frame.
+// Triangles are filled row by row, four pixels at a time with SSE2.
+class SoftwareRasterizer
+{
+public:
+    struct Config
+    {
+        unsigned int width = 96;
+        unsigned int height = 96;
+        float metersPerPixel = 0.4f;
+        // Position of the car from the top of the frame, in fraction of the height
+        float carPositionY = 0.75f;
+    };
+
+    // RGB
+    static constexpr size_t CHANNELS = 3;
+
+    SoftwareRasterizer() : SoftwareRasterizer(Config()) {}
+    SoftwareRasterizer(const Config& config);
+
+    void Configure(const Config& config);
+    const Config& GetConfig() const { return m_config; }
+    // Bytes of one frame
+    size_t GetFrameSize() const { return GetFrameSize(m_config); }
+    static size_t GetFrameSize(const Config& config) { return static_cast<size_t>(config.width) * config.height * CHANNELS; }
+
+    // To call each time a new track is generated
+    void SetTrack(const Track& track);
+
+    // One frame per car of egoCars, one after the other in out (egoCars.size() x GetFrameSize()).
+    // Frames of null cars are left untouched. The cars are placed in the world once for the batch.
+    void Render(const std::vector<const Car*>& egoCars, const std::unordered_map<unsigned int, Car*>& cars, uint8_t* out);
+    void Render(const Car& egoCar, const std::unordered_map<unsigned int, Car*>& cars, uint8_t* out);
+
+    size_t GetMemoryUsage() const;
+
+private:
+    struct Triangle
+    {
+        glm::vec2 p[3];
+        uint32_t color;
+    };
+
+    void AddQuad(const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3, const glm::vec2& p4, uint32_t color);
+    void PlaceCars(const std::unordered_map<unsigned int, Car*>& cars);
+    void RenderFrame(const Car& egoCar, uint8_t* out);
+    void DrawTriangle(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c, uint32_t color);
+
+    Config m_config;
+    // Background and track
+    std::vector<Triangle> m_sceneTriangles;
+    // World space, for culling
+    std::vector<RasterGeometry::Bounds> m_sceneBounds;
+    // Cars of the current batch, in world space
+    std::vector<Triangle> m_carTriangles;
+    std::vector<glm::vec2> m_carPositions;
+    // RGBA8, converted to RGB at the end of each frame
+    std::vector<uint32_t> m_frame;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <renderable/polygon.h>
+
+// Square of side 2 * halfSize centered on the origin, with a checker of little
+// squares computed in the fragment shader: one quad, whatever the number of squares.
+// The squares are the cells (i, j) of side squareSize with i and j even.
+class Checkerboard : public Polygon
+{
+public:
+    Checkerboard(float halfSize, float z, const glm::vec4& color, const glm::vec4& squareColor, float squareSize);
+
+    virtual void CreateShader() override;
+
+protected:
+    virtual void InternalDraw(const glm::mat4& mvp, RenderState& state) const override;
+
+    glm::vec4 m_squareColor;
+    float m_squareSize;
+    int m_squareColorLocation = -1;
+    int m_squareSizeLocation = -1;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <renderable/renderable.h>
+#include <vector>
+
+class Mesh;
+
+// Draws a shared mesh many times in one call, each instance with its own
+// model matrix and color (per-instance attributes).
+class InstancedMesh : public Renderable
+{
+public:
+    InstancedMesh(const Mesh* mesh);
+    virtual ~InstancedMesh();
+
+    virtual void CreateShader() override;
+    virtual unsigned int GetVertexArray() const override {return m_VAO;}
+
+    // Upload the instances of the frame, transforms and colors are nbInstances long
+    void SetInstances(const glm::mat4* transforms, const glm::vec4* colors, unsigned int nbInstances);
+    unsigned int GetNbInstances() const {return m_nbInstances;}
+
+protected:
+    virtual void InternalDraw(const glm::mat4& mvp, RenderState& state) const override;
+
+    const Mesh* m_mesh;
+    unsigned int m_VAO;
+    unsigned int m_transformVBO;
+    unsigned int m_colorVBO;
+    unsigned int m_nbInstances = 0;
+    // In instances, the buffers are reallocated when it is exceeded
+    unsigned int m_capacity = 0;
+};
@@ -16,8 +16,10 @@ public:
 
     void UpdatePoints(const glm::vec3& p1, const glm::vec3& p2);
 
+    virtual unsigned int GetVertexArray() const override {return m_VAO;}
+
 protected:
-    virtual void InternalDraw(const glm::mat4& mvp) const override;
+    virtual void InternalDraw(const glm::mat4& mvp, RenderState& state) const override;
     
     unsigned int m_VBO;
     unsigned int m_VAO;
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <renderable/renderable.h>
+#include <vector>
+
+// Lines rebuilt every frame (debug figures), streamed into one dynamic buffer
+// and drawn in a single call, with a color per vertex.
+class LineBatch : public Renderable
+{
+public:
+    struct Vertex
+    {
+        glm::vec3 position;
+        glm::vec4 color;
+    };
+
+    LineBatch();
+    virtual ~LineBatch();
+
+    virtual void CreateShader() override;
+    virtual unsigned int GetVertexArray() const override {return m_VAO;}
+
+    // Two vertices per line. The buffer is orphaned and refilled, it only grows
+    void SetLines(const Vertex* vertices, unsigned int nbVertices);
+    unsigned int GetNbLines() const {return m_nbVertices / 2;}
+
+protected:
+    virtual bool PrepareDraw(RenderQueue&, const RenderView&, bool) const override {return m_nbVertices > 0;}
+    virtual void InternalDraw(const glm::mat4& mvp, RenderState& state) const override;
+
+    unsigned int m_VAO;
+    unsigned int m_VBO;
+    unsigned int m_nbVertices = 0;
+    // In vertices, the buffer is reallocated when it is exceeded
+    unsigned int m_capacity = 0;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Immutable indexed geometry (positions only) in GL buffers, shared by the
+// renderables drawing it. Loaded once through MeshManager.
+class Mesh
+{
+public:
+    Mesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indexes);
+    ~Mesh();
+
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
+    // Binds the vertex and index buffers to the vertex array bound by the caller,
+    // positions at attribute 0
+    void Attach() const;
+
+    unsigned int GetNbIndexes() const { return m_nbIndexes; }
+    size_t GetGpuBytes() const { return m_gpuBytes; }
+
+private:
+    unsigned int m_VBO = 0;
+    unsigned int m_EBO = 0;
+    unsigned int m_nbIndexes = 0;
+    size_t m_gpuBytes = 0;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <renderable/mesh.h>
+#include <utils/singleton.h>
+
+// Meshes by name, uploaded the first time they are loaded
+class MeshManager : public Singleton<MeshManager>
+{
+public:
+    const Mesh* LoadMesh(const std::string& name, const std::vector<float>& vertices, const std::vector<unsigned int>& indexes);
+    // Release the GL buffers, while the context is alive
+    void Clear() { m_mapToMeshes.clear(); }
+
+    size_t GetGpuBytes() const;
+
+    MeshManager(Token) : Singleton() {}
+protected:
+    using MapToMeshes = std::unordered_map<std::string, std::unique_ptr<Mesh>>;
+    MapToMeshes m_mapToMeshes;
+};
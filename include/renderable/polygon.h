@@ -16,8 +16,10 @@ public:
     glm::vec4& GetColor() {return m_color;}
     const glm::vec4& GetColor() const {return m_color;}
 
+    virtual unsigned int GetVertexArray() const override {return m_VAO;}
+
 protected:
-    virtual void InternalDraw(const glm::mat4& mvp) const override;
+    virtual void InternalDraw(const glm::mat4& mvp, RenderState& state) const override;
     
     unsigned int m_VBO;
     unsigned int m_VAO;
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <glm/glm.hpp>
+#include <renderer/renderQueue.h>
 #include <shaders/shaders.h>
 #include <iostream>
 #include <unordered_map>
@@ -16,38 +18,87 @@ public:
     virtual ~Renderable() = default;
 
     virtual void CreateShader() = 0;
-    void Draw(const glm::mat4& mvp) const;
+    // Add this renderable and its children to the queue of the frame, unless its bounds are
+    // out of the view. Cached MVPs are only recomputed when the camera or the renderable moved
+    void Submit(RenderQueue& queue, const RenderView& view) const;
 
-    glm::mat4 GetTransform() const;
+    // Local box of the geometry in the xy plane, children included. Without bounds, never culled
+    void SetBounds(const glm::vec2& min, const glm::vec2& max) {m_boundsMin = min; m_boundsMax = max; m_hasBounds = true; m_worldDirty = true;}
+    bool HasBounds() const {return m_hasBounds;}
+
+    const Shader* GetShader() const {return m_shader;}
+    virtual unsigned int GetVertexArray() const {return 0;}
+
+    RenderLayer GetLayer() const {return m_layer;}
+    void SetLayer(RenderLayer layer) {m_layer = layer;}
+
+    // Relative to the parent, cached until the position, the rotation or the scale changes
+    const glm::mat4& GetTransform() const;
+    // translate * rotate around z * scale, without the generic glm calls
+    static glm::mat4 ComputeTransform2D(const glm::vec3& position, float angle, const glm::vec3& scale);
     
     const glm::vec3& GetPosition() const {return m_position;}
-    glm::vec3& GetPosition() {return m_position;}
+    void SetPosition(const glm::vec3& position) {m_position = position; MarkTransformDirty();}
 
     const glm::vec3& GetRotation() const {return m_rotation;}
-    glm::vec3& GetRotation() {return m_rotation;}
+    void SetRotation(const glm::vec3& rotation) {m_rotation = rotation; MarkTransformDirty();}
     void SetRoationFromMatrix(const glm::mat4& mat);
 
     const glm::vec3& GetScale() const {return m_scale;}
-    glm::vec3& GetScale() {return m_scale;}
+    void SetScale(const glm::vec3& scale) {m_scale = scale; MarkTransformDirty();}
 
     unsigned int GetId() const {return m_ID;}
 
+    // Size of the GL buffers owned by this renderable (children excluded)
+    size_t GetGpuBytes() const {return m_gpuBytes;}
+
     void AddChild(Renderable* child);
     Renderable* GetChild(unsigned int id);
     void RemoveChild(unsigned int id);
 protected:
-    virtual void InternalDraw(const glm::mat4&) const {};
+    friend class RenderQueue;
+
+    void Submit(RenderQueue& queue, const RenderView& view, const glm::mat4* parentWorld, bool parentChanged) const;
+    void MarkTransformDirty() {m_transformDirty = true; m_worldDirty = true;}
+    void MarkChildrenDirty() const;
+    // Axis aligned box, in the xy plane, of a local box once transformed
+    static void TransformBounds(const glm::mat4& transform, const glm::vec2& min, const glm::vec2& max, glm::vec2& outMin, glm::vec2& outMax);
+
+    // Called by Submit once the renderable is in the view and its world transform is up to date.
+    // Return false to skip its draw this frame (the children are still submitted)
+    virtual bool PrepareDraw(RenderQueue&, const RenderView&, bool /*worldChanged*/) const {return true;}
+
+    // The program and the vertex array are bound through the state, which skips redundant binds
+    virtual void InternalDraw(const glm::mat4&, RenderState&) const {};
 
     Shader* m_shader = nullptr;
 
     glm::vec3 m_position = glm::vec3(0.0f);
     glm::vec3 m_rotation = glm::vec3(0.0f);
     glm::vec3 m_scale = glm::vec3(1.0f, 1.0f, 1.0f);
+    RenderLayer m_layer = RenderLayer_Background;
+
+    // Caches of the transforms. World includes the parents, MVP the view projection of viewVersion.
+    // GetTransform refreshes the local one, only Submit refreshes the world one
+    mutable glm::mat4 m_transform = glm::mat4(1.0f);
+    mutable glm::mat4 m_worldTransform = glm::mat4(1.0f);
+    mutable glm::mat4 m_mvp = glm::mat4(1.0f);
+    mutable bool m_transformDirty = true;
+    mutable bool m_worldDirty = true;
+    mutable uint64_t m_viewVersion = 0;
+
+    bool m_hasBounds = false;
+    glm::vec2 m_boundsMin = glm::vec2(0.0f);
+    glm::vec2 m_boundsMax = glm::vec2(0.0f);
+    // In world, updated with the world transform
+    mutable glm::vec2 m_worldBoundsMin = glm::vec2(0.0f);
+    mutable glm::vec2 m_worldBoundsMax = glm::vec2(0.0f);
 
     using MapIdToRenderable = std::unordered_map<unsigned int, Renderable*>;
     MapIdToRenderable m_children;
 
     unsigned int m_ID;
+    size_t m_gpuBytes = 0;
 private:
     static inline unsigned int CURRENT_ID = 0;
 };
\ No newline at end of file
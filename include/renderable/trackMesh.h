@@ -0,0 +1,54 @@
+#pragma once
+
+#include <renderable/renderable.h>
+#include <vector>
+
+// Road and borders of a track in one static buffer with a color per vertex.
+// The index buffer is split in chunks with bounds: the chunks in the view are
+// drawn in a single call, out of view ones are skipped.
+class TrackMesh : public Renderable
+{
+public:
+    struct Vertex
+    {
+        glm::vec3 position;
+        // RGBA, normalized
+        uint8_t color[4];
+    };
+
+    // Indexes [firstIndex, firstIndex + nbIndexes), local box in the xy plane
+    struct Chunk
+    {
+        unsigned int firstIndex;
+        unsigned int nbIndexes;
+        glm::vec2 min;
+        glm::vec2 max;
+    };
+
+    TrackMesh();
+    virtual ~TrackMesh();
+
+    virtual void CreateShader() override;
+    virtual unsigned int GetVertexArray() const override {return m_VAO;}
+
+    // Upload a new track, replacing the previous one. Chunks are sorted by firstIndex
+    void SetGeometry(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indexes, const std::vector<Chunk>& chunks);
+    unsigned int GetNbChunks() const {return static_cast<unsigned int>(m_chunks.size());}
+
+protected:
+    virtual bool PrepareDraw(RenderQueue& queue, const RenderView& view, bool worldChanged) const override;
+    virtual void InternalDraw(const glm::mat4& mvp, RenderState& state) const override;
+
+    unsigned int m_VAO;
+    unsigned int m_VBO;
+    unsigned int m_EBO;
+
+    std::vector<Chunk> m_chunks;
+    // In world, updated with the world transform
+    mutable std::vector<glm::vec2> m_worldChunkBounds;
+    mutable glm::mat4 m_chunkBoundsTransform = glm::mat4(1.0f);
+    mutable bool m_chunkBoundsDirty = true;
+    // Ranges of the visible chunks, contiguous ones merged, for glMultiDrawElements
+    mutable std::vector<int> m_drawCounts;
+    mutable std::vector<const void*> m_drawOffsets;
+};
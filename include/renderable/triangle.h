@@ -13,8 +13,10 @@ public:
 
     virtual void CreateShader() override;
 
+    virtual unsigned int GetVertexArray() const override {return m_VAO;}
+
 protected:
-    virtual void InternalDraw(const glm::mat4& mvp) const override;
+    virtual void InternalDraw(const glm::mat4& mvp, RenderState& state) const override;
     
     unsigned int m_VBO;
     unsigned int m_VAO;
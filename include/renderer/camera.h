@@ -49,6 +49,9 @@ public:
 
     // Only available in Orthographic view
     void Zoom(float factor);
+    // Axis aligned box of the xy plane seen by the orthographic camera, rotation included.
+    // False in perspective view
+    bool GetOrthographicBounds(glm::vec2& min, glm::vec2& max) const;
 
 private:
     OrthographicParams m_orthgraphicParams;
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Renderable;
+class Shader;
+
+// Draw order of the renderables. Within a layer, items are grouped by shader
+// then by vertex array, so the queue can skip the binds that do not change.
+enum RenderLayer : uint8_t
+{
+    RenderLayer_Background,
+    RenderLayer_Track,
+    RenderLayer_Cars,
+    RenderLayer_Debug
+};
+
+// GL work of a frame, counted by RenderState
+struct RenderStats
+{
+    unsigned int nbItems = 0;
+    unsigned int nbDrawCalls = 0;
+    unsigned int nbProgramChanges = 0;
+    unsigned int nbVertexArrayChanges = 0;
+    // Binds skipped because the state was already set
+    unsigned int nbSkippedChanges = 0;
+    // World transforms recomputed, the others were cached
+    unsigned int nbTransformUpdates = 0;
+    // Renderables (children included) outside of the view, not submitted
+    unsigned int nbCulled = 0;
+
+    void Clear() { *this = RenderStats(); }
+};
+
+// Camera of a frame, as seen by Renderable::Submit
+struct RenderView
+{
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    // Changed with viewProjection, renderables keep their MVP while it does not
+    uint64_t version = 0;
+    // Renderables with bounds outside of this box (xy plane, world) are not submitted
+    bool cull = false;
+    glm::vec2 min = glm::vec2(0.0f);
+    glm::vec2 max = glm::vec2(0.0f);
+
+    bool Overlaps(const glm::vec2& boundsMin, const glm::vec2& boundsMax) const
+    {
+        return boundsMin.x <= max.x && boundsMax.x >= min.x && boundsMin.y <= max.y && boundsMax.y >= min.y;
+    }
+};
+
+// Bound program and vertex array while drawing a queue, so renderables only
+// call GL when the state changes
+class RenderState
+{
+public:
+    void UseShader(const Shader* shader);
+    void BindVertexArray(unsigned int vertexArray);
+    void SetLineWidth(float width);
+    void CountDrawCall() { m_stats.nbDrawCalls++; }
+
+    // Unbind the program and the vertex array, to leave a known state at the end of a frame
+    void Reset();
+
+    const RenderStats& GetStats() const { return m_stats; }
+    RenderStats& GetStats() { return m_stats; }
+
+private:
+    unsigned int m_program = 0;
+    unsigned int m_vertexArray = 0;
+    float m_lineWidth = 1.0f;
+    RenderStats m_stats;
+};
+
+// Renderables of a frame with their MVP, children flattened. Buffers are
+// kept between frames.
+class RenderQueue
+{
+public:
+    void Clear();
+    void Add(const Renderable* renderable, const glm::mat4& mvp);
+    void CountTransformUpdate() { m_nbTransformUpdates++; }
+    void CountCulled() { m_nbCulled++; }
+    // By layer, shader and vertex array. Equal keys keep their submission order
+    void Sort();
+    void Draw(RenderState& state) const;
+
+    size_t GetSize() const { return m_items.size(); }
+
+private:
+    struct Item
+    {
+        const Renderable* renderable;
+        glm::mat4 mvp;
+    };
+
+    struct SortKey
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    std::vector<Item> m_items;
+    // Drawn in this order, sorted or not
+    std::vector<SortKey> m_order;
+    unsigned int m_nbTransformUpdates = 0;
+    unsigned int m_nbCulled = 0;
+};
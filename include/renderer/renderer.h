@@ -2,6 +2,7 @@
 
 #include <unordered_map>
 #include <renderer/camera.h>
+#include <renderer/renderQueue.h>
 #include <functional>
 #include <unordered_map>
 #include <utils/singleton.h>
@@ -14,6 +15,10 @@ class Renderer : public Singleton<Renderer>
 {
 public:
     int Initialize(unsigned int width, unsigned int height);
+    // Render in the framebuffer bound in the GL context current on this thread, without
+    // window (offscreen checks). loadProc resolves the GL functions of that context
+    using LoadProc = void* (*)(const char* name);
+    int InitializeWithContext(unsigned int width, unsigned int height, LoadProc loadProc);
     void Close();
 
     void Render();
@@ -42,6 +47,16 @@ public:
     void Enable(bool enable) {m_enable = enable;}
     bool IsEnabled() {return m_enable;}
 
+    // Draw the queue by layer, shader and vertex array (on by default), or in submission order
+    void EnableSorting(bool enable) {m_sortQueue = enable;}
+    // Skip the renderables with bounds out of the orthographic camera (on by default)
+    void EnableCulling(bool enable) {m_cullQueue = enable;}
+    bool IsCullingEnabled() const {return m_cullQueue;}
+    // Camera of the last rendered frame
+    const RenderView& GetView() const {return m_view;}
+    // Counts of the last rendered frame
+    const RenderStats& GetStats() const {return m_state.GetStats();}
+
     unsigned int RegisterInputCallback(int inputKey, std::function<void(int)> callback);
     void RemoveInputCallback(unsigned int id);
     void ClearInputCallbacks() { m_inputCallbacks.clear(); }
@@ -53,6 +68,12 @@ private:
     using MapToRenderable = std::unordered_map<unsigned int, const Renderable*>;
     MapToRenderable m_mapToRenderable;
     Camera m_camera;
+    RenderQueue m_queue;
+    RenderState m_state;
+    // Version changed each time the view projection changes, see Renderable::Submit
+    RenderView m_view;
+    bool m_sortQueue = true;
+    bool m_cullQueue = true;
 
     bool m_enable = true;
     bool m_initialize = false;
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <racingGame/gameView.h>
+#include <racingGame/sceneSnapshot.h>
+#include <renderable/lineBatch.h>
+#include <renderable/trackMesh.h>
+#include <renderer/renderQueue.h>
+#include <vector>
+
+class Checkerboard;
+class InstancedMesh;
+
+// OpenGL view of the game. Owns every renderable of the scene (background,
+// track, cars and debug lines) and the Renderer/ShaderManager singletons.
+class RendererGameView : public GameView
+{
+public:
+    RendererGameView() = default;
+    ~RendererGameView();
+
+    RendererGameView(const RendererGameView&) = delete;
+    RendererGameView& operator=(const RendererGameView&) = delete;
+
+    virtual int Initialize(const GameConfig& config) override;
+    virtual void Close() override;
+
+    virtual bool IsEnabled() const override { return m_enabled; }
+    virtual bool IsPaused() const override;
+    virtual bool RequestedClose() override;
+
+    virtual void ProcessInput() override;
+    virtual void Render(const GameManager& game) override;
+    virtual bool SupportsSnapshots() const override { return true; }
+    virtual void Render(const SceneSnapshot& snapshot) override;
+
+    virtual void UpdateCamera(const glm::vec2& position, float angle) override;
+
+    virtual void OnReset() override;
+    virtual void OnTrackGenerated(const Track& track) override;
+
+    virtual void AddMemoryUsage(MemoryReport& report) const override;
+
+private:
+    void CreateBackground();
+    void CreateTrackMesh();
+    void CreateCarMeshes();
+    void DestroyCarMeshes();
+    void ClearTrack();
+    void BuildTrack(const Track::Path& path, const std::vector<float>& betas, const std::vector<bool>& borders);
+    void Draw(const SceneSnapshot& snapshot);
+    void UpdateCars(const std::vector<SceneSnapshot::CarInstance>& cars);
+    void UpdateDebugLines(const std::vector<DebugManager::DebugLine>& lines);
+
+    template <typename T>
+    void DestroyRenderable(T*& renderable);
+
+    bool m_enabled = false;
+    bool m_holdsSingletons = false;
+
+    // Frame of the game drawn when not pipelined, reused
+    SceneSnapshot m_frame;
+    // Of the last snapshot drawn, the track is rebuilt when it changes
+    uint64_t m_trackVersion = 0;
+
+    // Grass squares computed in its shader, one quad
+    Checkerboard* m_background = nullptr;
+    // Road and borders in one buffer, chunks in the camera drawn in one call
+    TrackMesh* m_track = nullptr;
+    std::vector<TrackMesh::Vertex> m_trackVertices;
+    std::vector<unsigned int> m_trackIndexes;
+    std::vector<TrackMesh::Chunk> m_trackChunks;
+    // Every car in two draw calls: the hulls, then the wheels
+    InstancedMesh* m_hulls = nullptr;
+    InstancedMesh* m_wheels = nullptr;
+    std::vector<glm::mat4> m_hullTransforms;
+    std::vector<glm::vec4> m_hullColors;
+    std::vector<glm::mat4> m_wheelTransforms;
+    std::vector<glm::vec4> m_wheelColors;
+    // Every debug line in one draw call, refilled each frame
+    LineBatch* m_debugLines = nullptr;
+    std::vector<LineBatch::Vertex> m_debugVertices;
+};
@@ -1,6 +1,7 @@
 #pragma once
   
 #include <string>
+#include <unordered_map>
 #include <glm/glm.hpp>
 
 class Shader
@@ -20,6 +21,20 @@ public:
     void SetFloat(const std::string &name, float value) const;
     void SetVec4(const std::string &name, const glm::vec4 &value) const;
     void SetMat4(const std::string &name, const glm::mat4 &value) const;
+    // Same, with a location from GetUniformLocation (no lookup by name)
+    void SetFloat(int location, float value) const;
+    void SetVec4(int location, const glm::vec4 &value) const;
+    void SetMat4(int location, const glm::mat4 &value) const;
+
+    // Locations are read once, when the program is linked. -1 if the uniform is not active
+    int GetUniformLocation(const std::string &name) const;
+    int GetMvpLocation() const { return m_mvpLocation; }
+    int GetColorLocation() const { return m_colorLocation; }
 private:
     void CheckCompileErrors(unsigned int shader, const std::string& type) const;
+    void CacheUniformLocations();
+
+    std::unordered_map<std::string, int> m_uniformLocations;
+    int m_mvpLocation = -1;
+    int m_colorLocation = -1;
 };
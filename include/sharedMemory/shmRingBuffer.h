@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// Cross process primitives living inside a shared memory segment.
+// Everything here must stay trivially laid out: no pointers, no virtuals.
+
+// Sequence number other processes can sleep on (futex on Linux).
+// Producers Ring after publishing data, consumers call Prepare, check their
+// data one last time, then Wait with the value returned by Prepare.
+struct ShmDoorbell
+{
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> nbWaiters;
+
+    void Initialize();
+
+    uint32_t Prepare();
+    // Returns when the sequence changed, on timeout or spuriously
+    void Wait(uint32_t expectedSequence, int64_t timeoutUs);
+    void Cancel();
+    void Ring();
+};
+
+// Lock free single producer / single consumer ring of fixed size records.
+// Head and tail are free running counters, wrapped with the capacity mask.
+template<typename T, uint32_t CAPACITY>
+struct ShmRingBuffer
+{
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of 2");
+    static_assert(std::is_trivially_copyable_v<T>, "Records are copied between processes");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "Atomics must be lock free to be shared between processes");
+
+    constexpr static inline uint32_t MASK = CAPACITY - 1;
+
+    void Initialize()
+    {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+    bool TryPush(const T& record)
+    {
+        uint32_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead - tail.load(std::memory_order_acquire) == CAPACITY)
+            return false;
+        records[currentHead & MASK] = record;
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& record)
+    {
+        uint32_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail == head.load(std::memory_order_acquire))
+            return false;
+        record = records[currentTail & MASK];
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool IsEmpty() const
+    {
+        return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+    }
+
+    // Producer and consumer indexes on their own cache lines
+    alignas(64) std::atomic<uint32_t> head;
+    alignas(64) std::atomic<uint32_t> tail;
+    alignas(64) T records[CAPACITY];
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <racingGame/carAction.h>
+#include <racingGame/carState.h>
+#include <sharedMemory/shmRingBuffer.h>
+
+// Shared memory transport between simulator processes and a trainer.
+// The trainer creates a segment with one channel per simulator. Each channel
+// holds two rings: observations (simulator -> trainer) and actions (trainer ->
+// simulator). Records have a fixed layout derived from CarState and CarAction,
+// so nothing is serialized. POSIX shm + futex, Linux first (other UNIX fall
+// back to polling, Windows is not supported).
+
+struct ObservationRecord
+{
+    uint64_t step;
+    uint32_t envId;
+    uint32_t carIndex;
+    float observation[CarState::FLAT_SIZE];
+    float reward;
+    uint32_t done;
+    // Free for the user, the benchmark stores the send time
+    int64_t timestampNs;
+};
+
+struct ActionRecord
+{
+    uint64_t step;
+    uint32_t envId;
+    uint32_t carIndex;
+    float action[CarAction::FLAT_SIZE];
+    int64_t timestampNs;
+};
+
+struct ShmChannel
+{
+    constexpr static inline uint32_t CAPACITY = 1024;
+
+    ShmRingBuffer<ObservationRecord, CAPACITY> observations;
+    ShmRingBuffer<ActionRecord, CAPACITY> actions;
+    // Rung by the trainer when it pushed actions in this channel
+    ShmDoorbell actionsDoorbell;
+};
+
+class ShmTransport
+{
+public:
+    constexpr static inline uint32_t MAGIC = 0x52435348; // "RCSH"
+    constexpr static inline uint32_t VERSION = 1;
+
+    // name must start with a '/', see shm_open
+    ShmTransport(const std::string& name);
+    ~ShmTransport();
+
+    ShmTransport(const ShmTransport&) = delete;
+    ShmTransport& operator=(const ShmTransport&) = delete;
+
+    // Trainer side, create a new segment (an existing one is replaced)
+    int Create(uint32_t nbChannels);
+    // Simulator side, map a segment created by the trainer
+    int Open();
+    void Close();
+
+    uint32_t GetNbChannels() const;
+    ShmChannel& GetChannel(uint32_t index);
+
+    // Simulator side: push and wake up the trainer. Spins if the ring is full
+    void SendObservation(uint32_t channel, const ObservationRecord& record);
+    // Simulator side: wait for an action on our channel. Returns false on timeout
+    bool ReceiveAction(uint32_t channel, ActionRecord& record, int64_t timeoutUs);
+
+    // Trainer side: push an action and wake up the simulator. Spins if the ring is full
+    void SendAction(uint32_t channel, const ActionRecord& record);
+    // Trainer side: pop an observation from any channel, round robin.
+    // Returns false on timeout, otherwise channel holds where it came from.
+    bool ReceiveObservation(ObservationRecord& record, uint32_t& channel, int64_t timeoutUs);
+
+private:
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t nbChannels;
+        uint32_t observationSize;
+        uint32_t actionSize;
+        // Rung by any simulator when it pushed an observation
+        ShmDoorbell observationsDoorbell;
+    };
+
+    static size_t GetSegmentSize(uint32_t nbChannels);
+    int Map(size_t size, bool create);
+
+    std::string m_name;
+    bool m_owner = false;
+    void* m_data = nullptr;
+    size_t m_size = 0;
+    Header* m_header = nullptr;
+    ShmChannel* m_channels = nullptr;
+    uint32_t m_nextChannel = 0;
+};
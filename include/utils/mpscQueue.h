@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// Lock free bounded queue, many producer threads and one consumer thread.
+// Each cell carries a sequence number telling whether it is free for the push
+// of a turn or holds the record of a turn, so producers only race on the head
+// counter (one compare exchange) and never wait for each other.
+template<typename T, uint32_t CAPACITY>
+class MpscQueue
+{
+public:
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of 2");
+    static_assert(std::is_trivially_copyable_v<T>, "Records are copied in and out of the cells");
+
+    MpscQueue()
+    {
+        for (uint32_t i = 0; i < CAPACITY; ++i)
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // False if the queue is full, the record is dropped
+    bool TryPush(const T& record)
+    {
+        uint32_t position = m_head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = m_cells[position & MASK];
+            const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const int32_t difference = static_cast<int32_t>(sequence - position);
+            if (difference == 0)
+            {
+                // Free for this turn, take it unless another producer did
+                if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.record = record;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+                return false;
+            else
+                position = m_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Consumer thread only
+    bool TryPop(T& record)
+    {
+        Cell& cell = m_cells[m_tail & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != m_tail + 1)
+            return false;
+        record = cell.record;
+        // Free for the push of the next turn
+        cell.sequence.store(m_tail + CAPACITY, std::memory_order_release);
+        m_tail++;
+        return true;
+    }
+
+private:
+    constexpr static inline uint32_t MASK = CAPACITY - 1;
+
+    struct Cell
+    {
+        std::atomic<uint32_t> sequence;
+        T record;
+    };
+
+    // Producers and consumer counters on their own cache lines
+    alignas(64) std::atomic<uint32_t> m_head{0};
+    alignas(64) uint32_t m_tail = 0;
+    alignas(64) Cell m_cells[CAPACITY];
+};
@@ -9,9 +9,29 @@ class RandomEngine : public Singleton<RandomEngine>
 public:
     std::default_random_engine& GetGenerator()
     {
-        return m_generator;
+        return ms_threadGenerator != nullptr ? *ms_threadGenerator : m_generator;
     }
 
+    // While in scope, GetGenerator returns the given generator on the current thread.
+    // Gives each environment its own deterministic stream, whatever the thread it runs on.
+    class ScopedGenerator
+    {
+    public:
+        ScopedGenerator(std::default_random_engine& generator)
+            : m_previous(ms_threadGenerator)
+        {
+            ms_threadGenerator = &generator;
+        }
+
+        ~ScopedGenerator()
+        {
+            ms_threadGenerator = m_previous;
+        }
+
+    private:
+        std::default_random_engine* m_previous;
+    };
+
     void SetSeed(unsigned int seed)
     {
         m_generator.seed(seed);
@@ -26,5 +46,6 @@ public:
 private:
 
     static inline RandomEngine* ms_instance = nullptr;
+    static inline thread_local std::default_random_engine* ms_threadGenerator = nullptr;
     std::default_random_engine m_generator;
 };
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock free hand-off of the latest value between one writer and one reader
+// thread. The writer fills the back buffer and publishes it, the reader takes
+// the newest published one. Neither ever waits, values the reader did not
+// take in time are overwritten. Buffers are reused, keep their allocations.
+template<typename T>
+class TripleBuffer
+{
+public:
+    // Writer thread only
+    T& GetBack() { return m_buffers[m_back]; }
+    const T& GetBack() const { return m_buffers[m_back]; }
+    void Publish()
+    {
+        m_back = m_middle.exchange(static_cast<uint8_t>(m_back | FRESH), std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Reader thread only. True if a value was published since the last call, it is then in the front buffer
+    bool Acquire()
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & FRESH) == 0)
+            return false;
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T& GetFront() const { return m_buffers[m_front]; }
+
+private:
+    constexpr static inline uint8_t FRESH = 0x4;
+    constexpr static inline uint8_t INDEX_MASK = 0x3;
+
+    T m_buffers[3];
+    // Index of the buffer between the two threads, with the FRESH bit when the writer published it
+    alignas(64) std::atomic<uint8_t> m_middle{1};
+    alignas(64) uint8_t m_back = 0;
+    alignas(64) uint8_t m_front = 2;
+};
@@ -0,0 +1,15 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 localPos;
+
+uniform vec4 ourColor;
+uniform vec4 squareColor;
+uniform float squareSize;
+
+void main()
+{
+    // Cells with even coordinates are squares, mod is positive for negative cells too
+    vec2 cell = mod(floor(localPos / squareSize), 2.0);
+    FragColor = cell.x == 0.0 && cell.y == 0.0 ? squareColor : ourColor;
+}
@@ -0,0 +1,12 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 MVP;
+
+out vec2 localPos;
+
+void main()
+{
+    gl_Position = MVP * vec4(aPos, 1.0);
+    localPos = aPos.xy;
+}
@@ -0,0 +1,15 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor;
+layout (location = 2) in mat4 aModel;
+
+uniform mat4 MVP;
+
+out vec4 outColor;
+
+void main()
+{
+    // MVP is the view projection, each instance brings its model matrix
+    gl_Position = MVP * aModel * vec4(aPos, 1.0);
+    outColor = aColor;
+}
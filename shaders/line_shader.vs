@@ -0,0 +1,14 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor;
+
+uniform mat4 MVP;
+
+out vec4 outColor;
+
+void main()
+{
+    // Lines of a batch, in world space, each vertex with its color
+    gl_Position = MVP * vec4(aPos, 1.0);
+    outColor = aColor;
+}
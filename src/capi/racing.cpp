@@ -0,0 +1,223 @@
+#include <capi/racing.h>
+#include <racingGame/racingEnvironment.h>
+
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+struct RacingEnv
+{
+    RacingEnv(const RacingEnvironment::Config& config)
+        : environment(config)
+        , actions(config.nbCars * RacingEnvironment::ACTION_SIZE, 0.0f)
+    {
+    }
+
+    RacingEnvironment environment;
+    // Written by the caller between two steps
+    std::vector<float> actions;
+};
+
+namespace
+{
+    // No exception must cross the C boundary: reports it and returns errorValue instead
+    template<typename R, typename F>
+    R CatchAll(const char* function, R errorValue, F&& body)
+    {
+        try
+        {
+            return body();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << function << ": " << e.what() << std::endl;
+        }
+        catch (...)
+        {
+            std::cerr << function << ": unknown exception" << std::endl;
+        }
+        return errorValue;
+    }
+
+    template<typename F>
+    void CatchAll(const char* function, F&& body)
+    {
+        CatchAll(function, 0, [&body]()
+        {
+            body();
+            return 0;
+        });
+    }
+
+    void FillBuffer(RacingBuffer* buffer, const float* data, size_t rows, size_t columns, bool readOnly)
+    {
+        buffer->data = const_cast<float*>(data);
+        buffer->dataType = RACING_DTYPE_FLOAT32;
+        buffer->ndim = columns > 1 ? 2 : 1;
+        buffer->shape[0] = static_cast<int64_t>(rows);
+        buffer->shape[1] = columns > 1 ? static_cast<int64_t>(columns) : 0;
+        buffer->strides[0] = static_cast<int64_t>(columns * sizeof(float));
+        buffer->strides[1] = columns > 1 ? static_cast<int64_t>(sizeof(float)) : 0;
+        buffer->readOnly = readOnly ? 1 : 0;
+    }
+}
+
+uint32_t racing_get_api_version(void)
+{
+    return RACING_API_VERSION;
+}
+
+uint32_t racing_get_observation_size(void)
+{
+    return static_cast<uint32_t>(RacingEnvironment::OBSERVATION_SIZE);
+}
+
+uint32_t racing_get_action_size(void)
+{
+    return static_cast<uint32_t>(RacingEnvironment::ACTION_SIZE);
+}
+
+void racing_default_config(RacingConfig* config)
+{
+    if (config == nullptr)
+        return;
+
+    CatchAll("racing_default_config", [config]()
+    {
+        RacingEnvironment::Config defaultConfig;
+        config->nbCars = defaultConfig.nbCars;
+        config->seed = defaultConfig.seed;
+        config->frameSkip = defaultConfig.frameSkip;
+        config->maxEpisodeSteps = defaultConfig.maxEpisodeSteps;
+        config->spawningStrategy = static_cast<int32_t>(defaultConfig.spawningStrategy);
+        config->gridSize = defaultConfig.occupancyGrid ? defaultConfig.grid.size : 0;
+        config->gridCellSize = defaultConfig.grid.cellSize;
+        config->lidarRays = defaultConfig.lidarObservations ? defaultConfig.lidar.nbRays : 0;
+        config->lidarRange = defaultConfig.lidar.maxRange;
+    });
+}
+
+RacingEnv* racing_create(const RacingConfig* config)
+{
+    return CatchAll("racing_create", static_cast<RacingEnv*>(nullptr), [config]()
+    {
+        RacingConfig cConfig;
+        racing_default_config(&cConfig);
+        if (config != nullptr)
+            cConfig = *config;
+
+        if (cConfig.nbCars == 0 || cConfig.spawningStrategy < RACING_SPAWN_ALL_ON_START || cConfig.spawningStrategy > RACING_SPAWN_FORMULA1 ||
+            (cConfig.gridSize > 0 && !(cConfig.gridCellSize > 0.0f)) || (cConfig.lidarRays > 0 && !(cConfig.lidarRange > 0.0f)))
+        {
+            std::cerr << "racing_create: invalid config" << std::endl;
+            return static_cast<RacingEnv*>(nullptr);
+        }
+
+        RacingEnvironment::Config envConfig;
+        envConfig.nbCars = cConfig.nbCars;
+        envConfig.seed = cConfig.seed;
+        envConfig.frameSkip = cConfig.frameSkip;
+        envConfig.maxEpisodeSteps = cConfig.maxEpisodeSteps;
+        envConfig.spawningStrategy = static_cast<SpawningStrategy::Strategy>(cConfig.spawningStrategy);
+        envConfig.occupancyGrid = cConfig.gridSize > 0;
+        envConfig.grid.size = cConfig.gridSize;
+        envConfig.grid.cellSize = cConfig.gridCellSize;
+        envConfig.lidarObservations = cConfig.lidarRays > 0;
+        envConfig.lidar.nbRays = cConfig.lidarRays;
+        envConfig.lidar.maxRange = cConfig.lidarRange;
+
+        auto env = std::make_unique<RacingEnv>(envConfig);
+        if (env->environment.Initialize() != 0)
+            return static_cast<RacingEnv*>(nullptr);
+        return env.release();
+    });
+}
+
+void racing_destroy(RacingEnv* env)
+{
+    delete env;
+}
+
+int racing_reset(RacingEnv* env)
+{
+    if (env == nullptr)
+        return -1;
+    return CatchAll("racing_reset", -1, [env]()
+    {
+        env->environment.Reset();
+        return 0;
+    });
+}
+
+int racing_step(RacingEnv* env)
+{
+    if (env == nullptr)
+        return -1;
+    return CatchAll("racing_step", -1, [env]()
+    {
+        env->environment.Step(env->actions.data());
+        return 0;
+    });
+}
+
+int racing_get_observations(RacingEnv* env, RacingBuffer* buffer)
+{
+    if (env == nullptr || buffer == nullptr)
+        return -1;
+    return CatchAll("racing_get_observations", -1, [env, buffer]()
+    {
+        FillBuffer(buffer, env->environment.GetObservations(), env->environment.GetNbCars(), env->environment.GetObservationSize(), true);
+        return 0;
+    });
+}
+
+int racing_get_actions(RacingEnv* env, RacingBuffer* buffer)
+{
+    if (env == nullptr || buffer == nullptr)
+        return -1;
+    return CatchAll("racing_get_actions", -1, [env, buffer]()
+    {
+        FillBuffer(buffer, env->actions.data(), env->environment.GetNbCars(), RacingEnvironment::ACTION_SIZE, false);
+        return 0;
+    });
+}
+
+int racing_get_rewards(RacingEnv* env, RacingBuffer* buffer)
+{
+    if (env == nullptr || buffer == nullptr)
+        return -1;
+    return CatchAll("racing_get_rewards", -1, [env, buffer]()
+    {
+        FillBuffer(buffer, env->environment.GetRewards(), env->environment.GetNbCars(), 1, true);
+        return 0;
+    });
+}
+
+int racing_is_done(const RacingEnv* env)
+{
+    if (env == nullptr)
+        return 1;
+    return CatchAll("racing_is_done", 1, [env]() { return env->environment.IsDone() ? 1 : 0; });
+}
+
+uint32_t racing_get_episode_step(const RacingEnv* env)
+{
+    if (env == nullptr)
+        return 0;
+    return CatchAll("racing_get_episode_step", 0u, [env]() { return env->environment.GetEpisodeStep(); });
+}
+
+uint64_t racing_get_memory_usage(const RacingEnv* env)
+{
+    if (env == nullptr)
+        return 0;
+
+    return CatchAll("racing_get_memory_usage", uint64_t(0), [env]()
+    {
+        MemoryReport report;
+        env->environment.AddMemoryUsage(report);
+        report.Add("actions", env->actions.capacity() * sizeof(float));
+        return static_cast<uint64_t>(report.GetTotal() + sizeof(RacingEnv) - sizeof(RacingEnvironment));
+    });
+}
@@ -1,95 +1,80 @@
 #include <debugManager/debugManager.h>
-#include <renderer/renderer.h>
-#include <renderable/polygon.h>
-#include <utils/utils.h>
-#include <renderable/line.h>
 
-constexpr float LINE_WIDTH = 1.0f;
+#include <mutex>
 
-#ifndef M_PI
-#define M_PI 3.14159265359f
-#endif
-
-DebugManager::DebugFigure::~DebugFigure()
+namespace
 {
-    if (renderable != nullptr)
-    {
-        Renderer* renderer = Renderer::GetInstance();
-        renderer->RemoveRenderable(renderable->GetId());
-        delete renderable;
-    }
+    std::mutex s_internLock;
+    std::unordered_map<std::string, DebugManager::DebugId> s_internedIds;
 }
 
 void DebugManager::Enable(bool enable)
 {
-    if (m_enabled && !enable)
+    if (IsEnabled() && !enable)
         Clear();
 
-    m_enabled = enable && Renderer::GetInstance()->IsEnabled();
+    m_enabled.store(enable, std::memory_order_relaxed);
 }
 
 void DebugManager::Clear()
 {
-    m_mapDebugFigures.clear();
+    DebugLine line;
+    while (m_queue.TryPop(line)) {}
+    m_lines.clear();
+    m_lineIndexes.clear();
 }
 
-void DebugManager::Update()
+void DebugManager::Update(bool paused)
 {
-    auto it = m_mapDebugFigures.begin();
-    const Renderer* renderer = Renderer::GetInstance();
-    // Remove items that have no more time remaining
-    while (it != m_mapDebugFigures.end())
+    DebugLine line;
+    while (m_queue.TryPop(line))
     {
-        // Only decrease the number of frame remaining if we are not in pause
-        if (!renderer->paused)
-            --(it->second.frameTimeRemaining);
-
-        if (it->second.frameTimeRemaining < 0)
-            it = m_mapDebugFigures.erase(it);
+        auto it = m_lineIndexes.try_emplace(line.key, static_cast<uint32_t>(m_lines.size()));
+        if (it.second)
+            m_lines.push_back(line);
         else
-            ++it;
+            m_lines[it.first->second] = line;
     }
-}
-
-void DebugManager::DrawLine(const std::string& id, const glm::vec3& p1, const glm::vec3& p2, const glm::vec4& color, int frameTime)
-{
-    if (!m_enabled)
-        return;
 
-    Line* line = nullptr;
+    // Only decrease the number of frame remaining if we are not in pause
+    if (!paused)
+    {
+        for (DebugLine& debugLine : m_lines)
+            --debugLine.frameTimeRemaining;
+    }
 
-    auto it = m_mapDebugFigures.find(id);
-    if (it != m_mapDebugFigures.end())
+    // Remove items that have no more time remaining, swapped with the last one
+    size_t i = 0;
+    while (i < m_lines.size())
     {
-        line = dynamic_cast<Line*>(it->second.renderable);
-        if (line == nullptr)
+        if (m_lines[i].frameTimeRemaining >= 0)
         {
-            // Previous Id existed, but was not a polygon...
-            m_mapDebugFigures.erase(it);
-            it = m_mapDebugFigures.end();
+            ++i;
+            continue;
         }
-    }
 
-    if (line == nullptr)
-    {
-        line = new Line(p1, p2, color);
-    }
-    else
-    {
-        line->UpdatePoints(p1, p2);
+        m_lineIndexes.erase(m_lines[i].key);
+        if (i + 1 < m_lines.size())
+        {
+            m_lines[i] = m_lines.back();
+            m_lineIndexes[m_lines[i].key] = static_cast<uint32_t>(i);
+        }
+        m_lines.pop_back();
     }
+}
 
-    if (it != m_mapDebugFigures.end())
-    {
-        it->second.frameTimeRemaining = frameTime;
-    }
-    else
-    {
-        Renderer::GetInstance()->AddRenderable(line);
+DebugManager::DebugId DebugManager::Intern(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(s_internLock);
+    auto it = s_internedIds.try_emplace(name, static_cast<DebugId>(s_internedIds.size() + 1));
+    return it.first->second;
+}
 
-        it = m_mapDebugFigures.emplace(id, DebugFigure()).first;
-        it->second.id = id;
-        it->second.renderable = line;
-        it->second.frameTimeRemaining = frameTime;
-    }
-}
\ No newline at end of file
+void DebugManager::DrawLine(DebugKey key, const glm::vec3& p1, const glm::vec3& p2, const glm::vec4& color, int frameTime)
+{
+    if (!IsEnabled())
+        return;
+
+    if (!m_queue.TryPush({ key, p1, p2, color, frameTime }))
+        m_nbDroppedLines.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,140 @@
+#include <envPool/envPool.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+EnvPool::EnvPool(const Config& config)
+    : m_config(config)
+{
+    m_config.nbEnvs = std::max(m_config.nbEnvs, 1u);
+    if (m_config.batchSize == 0 || m_config.batchSize > m_config.nbEnvs)
+        m_config.batchSize = m_config.nbEnvs;
+}
+
+EnvPool::~EnvPool()
+{
+    // Wait for the environments still being simulated before destroying them
+    {
+        std::unique_lock<std::mutex> lock(m_doneLock);
+        m_doneCondition.wait(lock, [this]() { return m_nbInFlight == m_doneEnvs.size(); });
+    }
+    m_threadPool.reset();
+    m_slots.clear();
+}
+
+int EnvPool::Initialize()
+{
+    if (!m_slots.empty())
+        return 0;
+
+    m_slots.resize(m_config.nbEnvs);
+    // Setup is done sequentially, it touches the shared game config
+    for (unsigned int i = 0; i < m_config.nbEnvs; ++i)
+    {
+        RacingEnvironment::Config envConfig = m_config.envConfig;
+        envConfig.seed = m_config.envConfig.seed + i;
+
+        EnvSlot& slot = m_slots[i];
+        slot.env = std::make_unique<RacingEnvironment>(envConfig);
+        slot.actions.assign(GetActionSize(), 0.0f);
+        int errorCode = slot.env->Initialize();
+        if (errorCode != 0)
+        {
+            std::cerr << "Failed to initialize environment " << i << std::endl;
+            return errorCode;
+        }
+    }
+
+    m_threadPool = std::make_unique<WorkStealingThreadPool>(m_config.nbThreads, m_config.pinThreads);
+
+    // First reset of all the environments
+    std::vector<unsigned int> envIds(m_config.nbEnvs);
+    for (unsigned int i = 0; i < m_config.nbEnvs; ++i)
+        envIds[i] = i;
+    std::vector<float> actions(m_config.nbEnvs * GetActionSize(), 0.0f);
+    Send(envIds.data(), envIds.size(), actions.data());
+    return 0;
+}
+
+void EnvPool::Send(const unsigned int* envIds, size_t nbEnvIds, const float* actions)
+{
+    const size_t actionSize = GetActionSize();
+    for (size_t i = 0; i < nbEnvIds; ++i)
+    {
+        unsigned int envId = envIds[i];
+        EnvSlot& slot = m_slots[envId];
+        {
+            std::lock_guard<std::mutex> lock(m_doneLock);
+            if (slot.running)
+            {
+                std::cerr << "Environment " << envId << " is already running, action ignored" << std::endl;
+                continue;
+            }
+            slot.running = true;
+            m_nbInFlight++;
+        }
+        std::memcpy(slot.actions.data(), actions + i * actionSize, actionSize * sizeof(float));
+        m_threadPool->Submit([this, envId]() { RunEnv(envId); }, envId);
+    }
+}
+
+void EnvPool::Send(const float* actions)
+{
+    std::vector<unsigned int> envIds(m_config.nbEnvs);
+    for (unsigned int i = 0; i < m_config.nbEnvs; ++i)
+        envIds[i] = i;
+    Send(envIds.data(), envIds.size(), actions);
+}
+
+void EnvPool::RunEnv(unsigned int envId)
+{
+    EnvSlot& slot = m_slots[envId];
+    if (slot.needsReset)
+        slot.env->Reset();
+    else
+        slot.env->Step(slot.actions.data());
+    slot.needsReset = slot.env->IsDone();
+
+    {
+        std::lock_guard<std::mutex> lock(m_doneLock);
+        m_doneEnvs.push_back(envId);
+    }
+    m_doneCondition.notify_all();
+}
+
+size_t EnvPool::Recv(unsigned int* envIds, float* observations, float* rewards, uint8_t* dones, uint8_t* pixels)
+{
+    std::vector<unsigned int> received;
+    {
+        std::unique_lock<std::mutex> lock(m_doneLock);
+        m_doneCondition.wait(lock, [this]() { return m_doneEnvs.size() >= std::min<size_t>(m_config.batchSize, m_nbInFlight); });
+        const size_t nbReceived = std::min<size_t>(m_config.batchSize, m_doneEnvs.size());
+        received.assign(m_doneEnvs.begin(), m_doneEnvs.begin() + nbReceived);
+        m_doneEnvs.erase(m_doneEnvs.begin(), m_doneEnvs.begin() + nbReceived);
+    }
+
+    const size_t observationSize = GetObservationSize();
+    const size_t pixelObservationSize = GetPixelObservationSize();
+    const unsigned int nbCars = GetNbCars();
+    for (size_t i = 0; i < received.size(); ++i)
+    {
+        const RacingEnvironment& env = *m_slots[received[i]].env;
+        envIds[i] = received[i];
+        std::memcpy(observations + i * observationSize, env.GetObservations(), observationSize * sizeof(float));
+        std::memcpy(rewards + i * nbCars, env.GetRewards(), nbCars * sizeof(float));
+        dones[i] = env.IsDone() ? 1 : 0;
+        if (pixels != nullptr && pixelObservationSize > 0)
+            std::memcpy(pixels + i * pixelObservationSize, env.GetPixels(), pixelObservationSize);
+    }
+
+    // Only now the environments can be sent again
+    {
+        std::lock_guard<std::mutex> lock(m_doneLock);
+        for (unsigned int envId : received)
+            m_slots[envId].running = false;
+        m_nbInFlight -= received.size();
+    }
+    m_doneCondition.notify_all();
+    return received.size();
+}
@@ -0,0 +1,115 @@
+#include <envPool/workStealingThreadPool.h>
+#include <metrics/trace.h>
+
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif // __linux__
+
+WorkStealingThreadPool::WorkStealingThreadPool(unsigned int nbThreads, bool pinThreads)
+{
+    unsigned int nbCpus = std::max(std::thread::hardware_concurrency(), 1u);
+    if (nbThreads == 0)
+        nbThreads = nbCpus;
+
+    for (unsigned int i = 0; i < nbThreads; ++i)
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+
+    for (unsigned int i = 0; i < nbThreads; ++i)
+    {
+        m_threads.emplace_back(&WorkStealingThreadPool::WorkerLoop, this, i);
+
+#ifdef __linux__
+        if (pinThreads)
+        {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(i % nbCpus, &cpuSet);
+            if (pthread_setaffinity_np(m_threads.back().native_handle(), sizeof(cpu_set_t), &cpuSet) != 0)
+                std::cerr << "Failed to pin worker " << i << " to cpu " << i % nbCpus << std::endl;
+        }
+#else
+        (void)pinThreads;
+#endif // __linux__
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepLock);
+        m_stopRequested = true;
+    }
+    m_wakeUp.notify_all();
+
+    for (std::thread& thread : m_threads)
+        thread.join();
+}
+
+void WorkStealingThreadPool::Submit(Task task, unsigned int preferredWorker)
+{
+    WorkerQueue& queue = *m_queues[preferredWorker % m_queues.size()];
+    {
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sleepLock);
+        m_nbQueuedTasks++;
+    }
+    m_wakeUp.notify_one();
+}
+
+bool WorkStealingThreadPool::PopTask(unsigned int index, Task& task)
+{
+    // Own queue first, oldest task first
+    {
+        WorkerQueue& queue = *m_queues[index];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+
+    // Then steal from the others, from the back to not compete with their owner
+    for (size_t i = 1; i < m_queues.size(); ++i)
+    {
+        WorkerQueue& queue = *m_queues[(index + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            m_nbSteals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingThreadPool::WorkerLoop(unsigned int index)
+{
+    Trace::SetThreadName("EnvPool worker");
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_sleepLock);
+            m_wakeUp.wait(lock, [this]() { return m_stopRequested || m_nbQueuedTasks > 0; });
+            if (m_stopRequested)
+                return;
+            // Reserve a task, one of the queues is guaranteed to hold it
+            m_nbQueuedTasks--;
+        }
+
+        Task task;
+        while (!PopTask(index, task))
+            std::this_thread::yield();
+        task();
+    }
+}
@@ -0,0 +1,107 @@
+#include <inference/inferenceClient.h>
+#include <inference/inferenceProtocol.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif // WIN32
+
+InferenceClient::InferenceClient(const std::string& socketPath)
+    : m_socketPath(socketPath)
+{
+}
+
+InferenceClient::~InferenceClient()
+{
+    Disconnect();
+}
+
+int InferenceClient::Connect()
+{
+    if (m_fd >= 0)
+        return 0;
+
+    m_fd = InferenceProtocol::ConnectUnixSocket(m_socketPath.c_str());
+    if (m_fd < 0)
+    {
+        std::cerr << "Failed to connect to inference server at " << m_socketPath << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+void InferenceClient::Disconnect()
+{
+    if (m_fd < 0)
+        return;
+#ifndef WIN32
+    close(m_fd);
+#endif // WIN32
+    m_fd = -1;
+}
+
+bool InferenceClient::Infer(const float* state, uint32_t stateSize, float* action, uint32_t actionSize)
+{
+    return InferBatch(state, stateSize, action, actionSize, 1);
+}
+
+bool InferenceClient::InferBatch(const float* states, uint32_t stateSize, float* actions, uint32_t actionSize, uint32_t count)
+{
+    if (m_fd < 0)
+        return false;
+    if (count == 0)
+        return true;
+    if (stateSize > InferenceProtocol::MAX_PAYLOAD_SIZE)
+        return false;
+
+    const size_t responseSize = sizeof(InferenceProtocol::MessageHeader) + actionSize * sizeof(float);
+    const uint32_t chunkSize = static_cast<uint32_t>(std::clamp<size_t>(
+        InferenceProtocol::MAX_RESPONSE_BYTES_PER_SEND / responseSize, 1, InferenceProtocol::MAX_REQUESTS_PER_SEND));
+    for (uint32_t first = 0; first < count; first += chunkSize)
+    {
+        const uint32_t chunkCount = std::min(chunkSize, count - first);
+        if (!InferChunk(states + static_cast<size_t>(first) * stateSize, stateSize,
+                actions + static_cast<size_t>(first) * actionSize, actionSize, chunkCount))
+            return false;
+    }
+    return true;
+}
+
+bool InferenceClient::InferChunk(const float* states, uint32_t stateSize, float* actions, uint32_t actionSize, uint32_t count)
+{
+    // All the messages in one buffer, a single send
+    const uint64_t firstRequestId = m_nextRequestId;
+    const size_t messageSize = sizeof(InferenceProtocol::MessageHeader) + stateSize * sizeof(float);
+    m_sendBuffer.resize(messageSize * count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        char* message = m_sendBuffer.data() + i * messageSize;
+        const InferenceProtocol::MessageHeader header{InferenceProtocol::REQUEST_MAGIC, stateSize, m_nextRequestId++};
+        std::memcpy(message, &header, sizeof(header));
+        std::memcpy(message + sizeof(header), states + static_cast<size_t>(i) * stateSize, stateSize * sizeof(float));
+    }
+    if (!InferenceProtocol::SendAll(m_fd, m_sendBuffer.data(), m_sendBuffer.size()))
+    {
+        Disconnect();
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        InferenceProtocol::MessageHeader header;
+        if (!InferenceProtocol::ReceiveAll(m_fd, &header, sizeof(header)) ||
+            header.magic != InferenceProtocol::RESPONSE_MAGIC ||
+            header.requestId != firstRequestId + i ||
+            header.size != actionSize ||
+            !InferenceProtocol::ReceiveAll(m_fd, actions + static_cast<size_t>(i) * actionSize, actionSize * sizeof(float)))
+        {
+            std::cerr << "Invalid answer from inference server" << std::endl;
+            Disconnect();
+            return false;
+        }
+    }
+    return true;
+}
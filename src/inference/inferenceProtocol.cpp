@@ -0,0 +1,99 @@
+#include <inference/inferenceProtocol.h>
+
+#include <cstring>
+#include <iostream>
+
+#ifndef WIN32
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif // WIN32
+
+#ifndef WIN32
+
+bool InferenceProtocol::SendAll(int fd, const void* data, size_t size)
+{
+    const char* current = static_cast<const char*>(data);
+    while (size > 0)
+    {
+        ssize_t sent = send(fd, current, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+            continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            // Non blocking socket with a full buffer, wait until we can write again
+            pollfd pollFd{fd, POLLOUT, 0};
+            poll(&pollFd, 1, -1);
+            continue;
+        }
+        if (sent <= 0)
+            return false;
+        current += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool InferenceProtocol::ReceiveAll(int fd, void* data, size_t size)
+{
+    char* current = static_cast<char*>(data);
+    while (size > 0)
+    {
+        ssize_t received = recv(fd, current, size, 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received <= 0)
+            return false;
+        current += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+bool InferenceProtocol::SendMessage(int fd, uint32_t magic, uint64_t requestId, const float* payload, uint32_t size)
+{
+    // Single send to avoid splitting small messages in two packets
+    char buffer[sizeof(MessageHeader) + MAX_PAYLOAD_SIZE * sizeof(float)];
+    if (size > MAX_PAYLOAD_SIZE)
+        return false;
+
+    MessageHeader header{magic, size, requestId};
+    std::memcpy(buffer, &header, sizeof(header));
+    std::memcpy(buffer + sizeof(header), payload, size * sizeof(float));
+    return SendAll(fd, buffer, sizeof(header) + size * sizeof(float));
+}
+
+int InferenceProtocol::ConnectUnixSocket(const char* socketPath)
+{
+    sockaddr_un address{};
+    if (std::strlen(socketPath) >= sizeof(address.sun_path))
+    {
+        std::cerr << "Socket path too long: " << socketPath << std::endl;
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath, sizeof(address.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+#else
+
+// UNIX domain sockets are not supported on Windows for now
+bool InferenceProtocol::SendAll(int, const void*, size_t) { return false; }
+bool InferenceProtocol::ReceiveAll(int, void*, size_t) { return false; }
+bool InferenceProtocol::SendMessage(int, uint32_t, uint64_t, const float*, uint32_t) { return false; }
+int InferenceProtocol::ConnectUnixSocket(const char*) { return -1; }
+
+#endif // WIN32
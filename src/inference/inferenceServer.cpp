@@ -0,0 +1,276 @@
+#include <inference/inferenceServer.h>
+#include <inference/inferenceProtocol.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#ifndef WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif // WIN32
+
+namespace
+{
+    int64_t NowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Index in the flat CarState (see CarState::Flatten)
+    constexpr size_t VELOCITY_INDEX = 1;
+    constexpr size_t POINTS_FURTHER_INDEX = 12;
+    // Point 10m ahead, side component
+    constexpr size_t TARGET_SIDE_INDEX = POINTS_FURTHER_INDEX + 2 * 2 + 1;
+}
+
+InferenceServer::InferenceServer(const Config& config, Policy policy)
+    : m_config(config)
+    , m_policy(policy != nullptr ? policy : &InferenceServer::TrivialPolicy)
+{
+    m_config.maxBatchSize = std::max(m_config.maxBatchSize, 1u);
+    m_pendingRequests.reserve(m_config.maxBatchSize);
+    m_batchStates.resize(static_cast<size_t>(m_config.maxBatchSize) * m_config.stateSize);
+    m_batchActions.resize(static_cast<size_t>(m_config.maxBatchSize) * m_config.actionSize);
+}
+
+void InferenceServer::TrivialPolicy(const float* states, size_t batchSize, float* actions)
+{
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+        const float* state = states + i * CarState::FLAT_SIZE;
+        float* action = actions + i * CarAction::FLAT_SIZE;
+
+        // Steer towards the point 10m ahead (on the positive side, a negative steer), keep a low speed
+        CarAction carAction;
+        carAction.steer = std::clamp(-2.0f * state[TARGET_SIDE_INDEX], -1.0f, 1.0f);
+        carAction.gas = state[VELOCITY_INDEX] < 0.3f ? 1.0f : 0.0f;
+        carAction.brake = state[VELOCITY_INDEX] > 0.5f ? 0.5f : 0.0f;
+        carAction.Flatten(action);
+    }
+}
+
+#ifndef WIN32
+
+InferenceServer::~InferenceServer()
+{
+    for (Client& client : m_clients)
+        close(client.fd);
+    m_clients.clear();
+
+    if (m_listenFd >= 0)
+    {
+        close(m_listenFd);
+        unlink(m_config.socketPath.c_str());
+    }
+}
+
+int InferenceServer::Initialize()
+{
+    if (m_config.stateSize > InferenceProtocol::MAX_PAYLOAD_SIZE || m_config.actionSize > InferenceProtocol::MAX_PAYLOAD_SIZE)
+    {
+        std::cerr << "State or action size too big for the inference protocol" << std::endl;
+        return -1;
+    }
+
+    sockaddr_un address{};
+    if (m_config.socketPath.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Socket path too long: " << m_config.socketPath << std::endl;
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, m_config.socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    m_listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_listenFd < 0)
+    {
+        std::cerr << "Failed to create the inference socket" << std::endl;
+        return -1;
+    }
+
+    // Remove a socket left by a previous server
+    unlink(m_config.socketPath.c_str());
+    if (bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(m_listenFd, 128) != 0)
+    {
+        std::cerr << "Failed to bind the inference socket on " << m_config.socketPath << std::endl;
+        close(m_listenFd);
+        m_listenFd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+int InferenceServer::Run()
+{
+    if (m_listenFd < 0)
+        return -1;
+
+    std::vector<pollfd> pollFds;
+    while (!m_stopRequested)
+    {
+        // Wake up when the oldest request exhausted its latency budget.
+        // Otherwise wake up regularly to check if we were asked to stop.
+        int64_t timeoutUs = 100000;
+        if (!m_pendingRequests.empty())
+            timeoutUs = std::max<int64_t>(0, m_oldestPendingUs + m_config.maxLatencyUs - NowUs());
+
+        pollFds.clear();
+        pollFds.push_back({m_listenFd, POLLIN, 0});
+        for (const Client& client : m_clients)
+            pollFds.push_back({client.fd, POLLIN, 0});
+
+        timespec timeout;
+        timeout.tv_sec = static_cast<time_t>(timeoutUs / 1000000);
+        timeout.tv_nsec = static_cast<long>((timeoutUs % 1000000) * 1000);
+        int nbReady = ppoll(pollFds.data(), pollFds.size(), &timeout, nullptr);
+        if (nbReady < 0 && errno != EINTR)
+        {
+            std::cerr << "Inference server poll failed: " << std::strerror(errno) << std::endl;
+            return -1;
+        }
+
+        if (nbReady > 0)
+        {
+            // Iterate backward so dropping a client doesn't shift the ones we didn't process yet
+            for (size_t i = pollFds.size() - 1; i > 0; --i)
+            {
+                if (pollFds[i].revents == 0)
+                    continue;
+                if ((pollFds[i].revents & (POLLERR | POLLHUP)) != 0 || !ReadClient(m_clients[i - 1]))
+                    DropClient(i - 1);
+            }
+
+            if ((pollFds[0].revents & POLLIN) != 0)
+                AcceptClient();
+        }
+
+        if (!m_pendingRequests.empty() && NowUs() - m_oldestPendingUs >= m_config.maxLatencyUs)
+            FlushBatch();
+    }
+
+    FlushBatch();
+    return 0;
+}
+
+void InferenceServer::AcceptClient()
+{
+    int fd = accept(m_listenFd, nullptr, nullptr);
+    if (fd < 0)
+        return;
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    Client client;
+    client.fd = fd;
+    m_clients.push_back(std::move(client));
+}
+
+void InferenceServer::DropClient(size_t clientIndex)
+{
+    int fd = m_clients[clientIndex].fd;
+    close(fd);
+    // The fd could be reused by a new client before the batch is flushed
+    for (PendingRequest& request : m_pendingRequests)
+    {
+        if (request.fd == fd)
+            request.fd = -1;
+    }
+    m_clients.erase(m_clients.begin() + clientIndex);
+}
+
+bool InferenceServer::ReadClient(Client& client)
+{
+    char buffer[16384];
+    while (true)
+    {
+        ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (received <= 0)
+            return false;
+        client.inbox.insert(client.inbox.end(), buffer, buffer + received);
+    }
+
+    const size_t messageSize = sizeof(InferenceProtocol::MessageHeader) + m_config.stateSize * sizeof(float);
+    size_t offset = 0;
+    while (client.inbox.size() - offset >= sizeof(InferenceProtocol::MessageHeader))
+    {
+        InferenceProtocol::MessageHeader header;
+        std::memcpy(&header, client.inbox.data() + offset, sizeof(header));
+        if (header.magic != InferenceProtocol::REQUEST_MAGIC || header.size != m_config.stateSize)
+        {
+            std::cerr << "Malformed inference request, dropping client" << std::endl;
+            return false;
+        }
+
+        if (client.inbox.size() - offset < messageSize)
+            break;
+
+        if (m_pendingRequests.empty())
+            m_oldestPendingUs = NowUs();
+
+        float* destination = m_batchStates.data() + m_pendingRequests.size() * m_config.stateSize;
+        std::memcpy(destination, client.inbox.data() + offset + sizeof(header), m_config.stateSize * sizeof(float));
+        m_pendingRequests.push_back({client.fd, header.requestId});
+        offset += messageSize;
+
+        if (m_pendingRequests.size() == m_config.maxBatchSize)
+        {
+            m_statistics.nbFullBatches++;
+            FlushBatch();
+        }
+    }
+    client.inbox.erase(client.inbox.begin(), client.inbox.begin() + offset);
+    return true;
+}
+
+void InferenceServer::FlushBatch()
+{
+    if (m_pendingRequests.empty())
+        return;
+
+    const size_t batchSize = m_pendingRequests.size();
+    m_policy(m_batchStates.data(), batchSize, m_batchActions.data());
+
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+        const PendingRequest& request = m_pendingRequests[i];
+        if (request.fd < 0)
+            continue;
+        // A failed send will be detected as a hang up on the next poll
+        InferenceProtocol::SendMessage(request.fd, InferenceProtocol::RESPONSE_MAGIC, request.requestId,
+            m_batchActions.data() + i * m_config.actionSize, m_config.actionSize);
+    }
+
+    m_statistics.nbRequests += batchSize;
+    m_statistics.nbBatches++;
+    m_statistics.biggestBatch = std::max(m_statistics.biggestBatch, static_cast<unsigned int>(batchSize));
+    m_pendingRequests.clear();
+}
+
+#else
+
+InferenceServer::~InferenceServer() {}
+
+int InferenceServer::Initialize()
+{
+    std::cerr << "The inference server is not supported on Windows" << std::endl;
+    return -1;
+}
+
+int InferenceServer::Run() { return -1; }
+void InferenceServer::AcceptClient() {}
+bool InferenceServer::ReadClient(Client&) { return false; }
+void InferenceServer::DropClient(size_t) {}
+void InferenceServer::FlushBatch() {}
+
+#endif // WIN32
@@ -1,20 +1,56 @@
 #include <cstring>
+#include <cstdlib>
+#include <memory>
 
 #include <racingGame/gameManager.h>
 #include <racingGame/scenarios/humanSinglePlayerScenario.h>
 #include <racingGame/scenarios/humanMultiplayerScenario.h>
+#include <racingGame/scenarios/remotePolicyScenario.h>
+#include <renderer/rendererGameView.h>
+#include <metrics/trace.h>
 
 int main(int argc, char** argv)
 {
     GameConfig config;
-    config.enableRendering = argc > 1 ? strcmp(argv[1], "--no-render") != 0 : true;
-    //config.enableRendering = true;
+    config.enableRendering = true;
     config.attachCamera = true;
     config.debugInfo = true;
 
-    HumanSinglePlayerScenario scenario;
+    // --inference <socket> <nbCars> : cars are driven by a local InferenceServer
+    const char* inferenceSocket = nullptr;
+    unsigned int nbRemoteCars = 1;
+    // --trace <file.json> : record trace zones and write them as a Chrome trace on exit
+    const char* tracePath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--no-render") == 0)
+            config.enableRendering = false;
+        else if (strcmp(argv[i], "--inference") == 0 && i + 2 < argc)
+        {
+            inferenceSocket = argv[++i];
+            nbRemoteCars = static_cast<unsigned int>(std::atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+            tracePath = argv[++i];
+        // Simulation on a worker thread, this one only renders (not with human play)
+        else if (strcmp(argv[i], "--render-thread") == 0)
+            config.renderThread = true;
+    }
+
+    std::unique_ptr<Scenario> scenario;
+    config.humanPlay = inferenceSocket == nullptr;
+    if (inferenceSocket != nullptr)
+        scenario = std::make_unique<RemotePolicyScenario>(nbRemoteCars, inferenceSocket);
+    else
+        scenario = std::make_unique<HumanSinglePlayerScenario>();
     //HumanMultiplayerScenario scenario(2);
-    GameManager gameManager(config, &scenario);
-    
-    return gameManager.Run();
+    RendererGameView view;
+    GameManager gameManager(config, scenario.get(), &view);
+
+    Trace::SetThreadName("Main");
+    Trace::Enable(tracePath != nullptr);
+    int errorCode = gameManager.Run();
+    if (tracePath != nullptr)
+        Trace::WriteChromeTrace(tracePath);
+    return errorCode;
 }
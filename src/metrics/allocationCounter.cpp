@@ -0,0 +1,135 @@
+#include <metrics/allocationCounter.h>
+
+#ifdef RACING_TRACK_ALLOCATIONS
+#include <Box2D/Common/b2Settings.h>
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Constant initialized, no guard needed even when called before main
+    thread_local AllocationCounts t_counts;
+
+    void* Allocate(std::size_t size)
+    {
+        t_counts.nbAllocations++;
+        t_counts.bytes += size;
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* AllocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        t_counts.nbAllocations++;
+        t_counts.bytes += size;
+        std::size_t align = static_cast<std::size_t>(alignment);
+        // aligned_alloc requires a size multiple of the alignment
+        std::size_t alignedSize = (size + align - 1) / align * align;
+        return std::aligned_alloc(align, alignedSize == 0 ? align : alignedSize);
+    }
+
+    void Free(void* pointer)
+    {
+        if (pointer == nullptr)
+            return;
+        t_counts.nbFrees++;
+        std::free(pointer);
+    }
+
+    // Box2D allocates with malloc (block allocator chunks, stack allocator overflow,
+    // broad-phase and tree growth), not through operator new
+    void* AllocateBox2D(int32 size)
+    {
+        return Allocate(static_cast<std::size_t>(size));
+    }
+
+    // Installed before main, so before any world is created
+    struct Box2DAllocatorHook
+    {
+        Box2DAllocatorHook() { b2SetAllocator(AllocateBox2D, Free); }
+    };
+    const Box2DAllocatorHook BOX2D_ALLOCATOR_HOOK;
+}
+
+void* operator new(std::size_t size)
+{
+    void* pointer = Allocate(size);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    void* pointer = AllocateAligned(size, alignment);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return AllocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { Free(pointer); }
+void operator delete[](void* pointer) noexcept { Free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { Free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { Free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { Free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { Free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { Free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { Free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { Free(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { Free(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { Free(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { Free(pointer); }
+
+bool AllocationCounter::IsEnabled()
+{
+    return true;
+}
+
+AllocationCounts AllocationCounter::Get()
+{
+    return t_counts;
+}
+
+#else
+
+bool AllocationCounter::IsEnabled()
+{
+    return false;
+}
+
+AllocationCounts AllocationCounter::Get()
+{
+    return AllocationCounts();
+}
+
+#endif // RACING_TRACK_ALLOCATIONS
@@ -0,0 +1,146 @@
+#include <metrics/budgetGovernor.h>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    constexpr unsigned int LEVEL_NO_DEBUG_LINES = 1;
+    constexpr unsigned int LEVEL_SPARSE_RANKINGS = 2;
+    constexpr unsigned int LEVEL_NO_CAMERA_SMOOTHING = 3;
+}
+
+BudgetGovernor::BudgetGovernor(const Config& config)
+{
+    Configure(config);
+}
+
+void BudgetGovernor::Configure(const Config& config)
+{
+    m_config = config;
+
+    // One more level each time the iterations can be halved
+    m_maxLevel = LEVEL_NO_CAMERA_SMOOTHING;
+    int velocityIterations = m_config.maxVelocityIterations;
+    int positionIterations = m_config.maxPositionIterations;
+    while (velocityIterations > m_config.minVelocityIterations || positionIterations > m_config.minPositionIterations)
+    {
+        velocityIterations = std::max(velocityIterations / 2, m_config.minVelocityIterations);
+        positionIterations = std::max(positionIterations / 2, m_config.minPositionIterations);
+        m_maxLevel++;
+    }
+
+    m_level = 0;
+    m_settings = ComputeSettings(0);
+    m_nbFrames = 0;
+    m_nbOverruns = 0;
+    m_nbHeadroomFrames = 0;
+    m_restoreDelay = m_config.headroomFrames;
+    m_cooldown = 0;
+    m_decisions.clear();
+    m_nbLevelChanges = 0;
+    m_framesPerLevel.assign(m_maxLevel + 1, 0);
+}
+
+QualitySettings BudgetGovernor::ComputeSettings(unsigned int level) const
+{
+    QualitySettings settings;
+    settings.debugLines = level < LEVEL_NO_DEBUG_LINES;
+    settings.rankingInterval = level < LEVEL_SPARSE_RANKINGS ? 1 : RANKING_INTERVAL;
+    settings.cameraSmoothing = level < LEVEL_NO_CAMERA_SMOOTHING;
+    settings.velocityIterations = m_config.maxVelocityIterations;
+    settings.positionIterations = m_config.maxPositionIterations;
+    for (unsigned int i = LEVEL_NO_CAMERA_SMOOTHING; i < level; ++i)
+    {
+        settings.velocityIterations = std::max(settings.velocityIterations / 2, m_config.minVelocityIterations);
+        settings.positionIterations = std::max(settings.positionIterations / 2, m_config.minPositionIterations);
+    }
+    return settings;
+}
+
+std::string BudgetGovernor::DescribeLevel(unsigned int level) const
+{
+    if (level == 0)
+        return "full quality";
+
+    QualitySettings settings = ComputeSettings(level);
+    std::stringstream description;
+    description << "no debug lines";
+    if (settings.rankingInterval > 1)
+        description << ", rankings every " << settings.rankingInterval << " frames";
+    if (!settings.cameraSmoothing)
+        description << ", no camera smoothing";
+    if (level > LEVEL_NO_CAMERA_SMOOTHING)
+        description << ", " << settings.velocityIterations << "/" << settings.positionIterations << " solver iterations";
+    return description.str();
+}
+
+bool BudgetGovernor::Update(int64_t frameNs)
+{
+    m_framesPerLevel[m_level]++;
+    m_nbFrames++;
+
+    if (frameNs > m_config.budgetNs)
+        m_nbOverruns++;
+    else
+        m_nbOverruns = 0;
+
+    if (frameNs < static_cast<int64_t>(m_config.headroom * m_config.budgetNs))
+        m_nbHeadroomFrames++;
+    else
+        m_nbHeadroomFrames = 0;
+
+    if (m_cooldown > 0)
+    {
+        m_cooldown--;
+        return false;
+    }
+
+    if (m_nbOverruns >= m_config.overrunFrames && m_level < m_maxLevel)
+    {
+        // The last restore was too optimistic, wait longer before the next one
+        if (!m_decisions.empty() && m_decisions.back().toLevel < m_decisions.back().fromLevel &&
+            m_nbFrames - m_decisions.back().frame < 2 * m_restoreDelay)
+            m_restoreDelay = std::min(2 * m_restoreDelay, m_config.maxHeadroomFrames);
+        SetLevel(m_level + 1, frameNs);
+        return true;
+    }
+    if (m_nbHeadroomFrames >= m_restoreDelay && m_level > 0)
+    {
+        SetLevel(m_level - 1, frameNs);
+        return true;
+    }
+    return false;
+}
+
+void BudgetGovernor::SetLevel(unsigned int level, int64_t frameNs)
+{
+    if (m_decisions.size() == MAX_DECISIONS)
+        m_decisions.erase(m_decisions.begin());
+    m_decisions.push_back({ m_nbFrames, m_level, level, frameNs });
+    m_nbLevelChanges++;
+
+    std::cout << "Budget governor: level " << m_level << " -> " << level << " (" << DescribeLevel(level)
+              << ") at frame " << m_nbFrames << ", last frame " << frameNs / 1000 << "us" << std::endl;
+
+    m_level = level;
+    m_settings = ComputeSettings(level);
+    m_nbOverruns = 0;
+    m_nbHeadroomFrames = 0;
+    m_cooldown = m_config.cooldownFrames;
+}
+
+void BudgetGovernor::PrintSummary(std::ostream& stream) const
+{
+    if (m_nbFrames == 0)
+        return;
+
+    stream << "Budget governor: " << m_nbLevelChanges << " level changes, frames per level:";
+    for (unsigned int level = 0; level <= m_maxLevel; ++level)
+    {
+        if (m_framesPerLevel[level] > 0)
+            stream << " " << level << ": " << m_framesPerLevel[level];
+    }
+    stream << std::endl;
+}
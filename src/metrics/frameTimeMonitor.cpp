@@ -0,0 +1,100 @@
+#include <metrics/frameTimeMonitor.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+    constexpr double MIN_FRAME_US = 1.0;
+    constexpr double MAX_FRAME_US = 1e8;
+    constexpr unsigned int SUB_BUCKETS = 64;
+}
+
+FrameTimeMonitor::FrameTimeMonitor(int64_t budgetNs)
+    : m_budgetNs(budgetNs)
+    , m_frameTimes(0, MIN_FRAME_US, MAX_FRAME_US, SUB_BUCKETS)
+{
+}
+
+const char* FrameTimeMonitor::GetPartName(Part part)
+{
+    if (part < STEP_PHASE_COUNT)
+        return GetStepPhaseName(static_cast<StepPhase>(part));
+    switch (part)
+    {
+    case Part_Render: return "render";
+    case Part_Other: return "other";
+    default: return "unknown";
+    }
+}
+
+void FrameTimeMonitor::Record(int64_t frameNs, const FrameTimings& step, int64_t renderNs)
+{
+    m_frameTimes.Add(frameNs / 1e3);
+    m_nbFrames++;
+
+    if (m_budgetNs <= 0 || frameNs <= m_budgetNs)
+        return;
+
+    std::array<int64_t, Part_Count> parts{};
+    for (size_t phase = 0; phase < STEP_PHASE_COUNT; ++phase)
+        parts[phase] = step.phaseNs[phase];
+    parts[Part_Render] = renderNs;
+    int64_t known = renderNs;
+    for (size_t phase = 0; phase < STEP_PHASE_COUNT; ++phase)
+        known += step.phaseNs[phase];
+    parts[Part_Other] = std::max<int64_t>(frameNs - known, 0);
+
+    unsigned int worst = 0;
+    for (unsigned int part = 1; part < Part_Count; ++part)
+    {
+        if (parts[part] > parts[worst])
+            worst = part;
+    }
+
+    m_nbOverruns++;
+    m_overrunsPerPart[worst]++;
+
+    std::cout << "Frame " << m_nbFrames << " took " << frameNs / 1000 << "us (budget " << m_budgetNs / 1000 << "us): "
+              << GetPartName(static_cast<Part>(worst)) << " " << parts[worst] / 1000 << "us";
+    if (step.nbSpawns > 0)
+        std::cout << ", " << step.nbSpawns << " spawns";
+    if (step[StepPhase::Reset] > 0 && worst != static_cast<unsigned int>(StepPhase::Reset))
+        std::cout << ", track reset " << step[StepPhase::Reset] / 1000 << "us";
+    std::cout << std::endl;
+}
+
+void FrameTimeMonitor::Clear()
+{
+    m_frameTimes.Clear();
+    m_nbFrames = 0;
+    m_nbOverruns = 0;
+    m_overrunsPerPart.fill(0);
+}
+
+void FrameTimeMonitor::PrintSummary(std::ostream& stream) const
+{
+    if (m_nbFrames == 0)
+        return;
+
+    stream << std::fixed << std::setprecision(0)
+           << "Frame times over " << m_nbFrames << " frames: p50 " << m_frameTimes.GetPercentile(0.5)
+           << "us, p99 " << m_frameTimes.GetPercentile(0.99) << "us, p99.9 " << m_frameTimes.GetPercentile(0.999)
+           << "us, max " << m_frameTimes.GetMax() << "us" << std::endl;
+    stream << "Frames over budget: " << m_nbOverruns;
+    if (m_nbOverruns > 0)
+    {
+        const char* separator = " (";
+        for (unsigned int part = 0; part < Part_Count; ++part)
+        {
+            if (m_overrunsPerPart[part] == 0)
+                continue;
+            stream << separator << GetPartName(static_cast<Part>(part)) << ": " << m_overrunsPerPart[part];
+            separator = ", ";
+        }
+        stream << ")";
+    }
+    stream << std::endl;
+    stream.unsetf(std::ios_base::floatfield);
+}
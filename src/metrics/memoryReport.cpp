@@ -0,0 +1,49 @@
+#include <metrics/memoryReport.h>
+
+#include <iomanip>
+#include <iostream>
+
+void MemoryReport::Add(const std::string& name, size_t bytes, size_t count)
+{
+    for (Entry& entry : m_entries)
+    {
+        if (entry.name == name)
+        {
+            entry.bytes += bytes;
+            entry.count += count;
+            return;
+        }
+    }
+    m_entries.push_back({ name, bytes, count });
+}
+
+size_t MemoryReport::GetBytes(const std::string& name) const
+{
+    for (const Entry& entry : m_entries)
+    {
+        if (entry.name == name)
+            return entry.bytes;
+    }
+    return 0;
+}
+
+size_t MemoryReport::GetTotal() const
+{
+    size_t total = 0;
+    for (const Entry& entry : m_entries)
+        total += entry.bytes;
+    return total;
+}
+
+void MemoryReport::Print(std::ostream& stream) const
+{
+    const size_t total = GetTotal();
+    for (const Entry& entry : m_entries)
+    {
+        stream << "    " << std::left << std::setw(24) << entry.name << std::right
+               << std::setw(12) << entry.bytes << " bytes" << std::setw(8) << entry.count << " objects"
+               << std::setw(7) << std::fixed << std::setprecision(1)
+               << (total > 0 ? 100.0 * entry.bytes / total : 0.0) << "%" << std::endl;
+    }
+    stream << "    " << std::left << std::setw(24) << "total" << std::right << std::setw(12) << total << " bytes" << std::endl;
+}
@@ -0,0 +1,163 @@
+#include <metrics/perfCounters.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // __linux__
+
+const char* GetPerfCounterName(PerfCounter counter)
+{
+    switch (counter)
+    {
+    case PerfCounter::Cycles: return "cycles";
+    case PerfCounter::Instructions: return "instructions";
+    case PerfCounter::L1DMisses: return "l1dMisses";
+    case PerfCounter::LLCMisses: return "llcMisses";
+    case PerfCounter::BranchMisses: return "branchMisses";
+    default: return "unknown";
+    }
+}
+
+#ifdef __linux__
+namespace
+{
+    void SetEventConfig(PerfCounter counter, perf_event_attr& attr)
+    {
+        attr.type = PERF_TYPE_HARDWARE;
+        switch (counter)
+        {
+        case PerfCounter::Cycles:
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfCounter::Instructions:
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfCounter::L1DMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case PerfCounter::LLCMisses:
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PerfCounter::BranchMisses:
+        default:
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        }
+    }
+
+    int OpenCounter(PerfCounter counter, int groupFd)
+    {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        SetEventConfig(counter, attr);
+        attr.read_format = PERF_FORMAT_GROUP;
+        // Only the leader starts disabled, the group is enabled at once
+        attr.disabled = groupFd < 0 ? 1 : 0;
+        // User space only, allowed with the default perf_event_paranoid
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+    }
+}
+#endif // __linux__
+
+PerfCounters::PerfCounters()
+{
+    m_fds.fill(-1);
+    m_slots.fill(-1);
+}
+
+PerfCounters::~PerfCounters()
+{
+    Close();
+}
+
+int PerfCounters::Initialize()
+{
+    Close();
+#ifdef __linux__
+    int firstError = 0;
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i)
+    {
+        PerfCounter counter = static_cast<PerfCounter>(i);
+        int fd = OpenCounter(counter, m_groupFd);
+        if (fd < 0)
+        {
+            if (firstError == 0)
+                firstError = errno;
+            continue;
+        }
+
+        if (m_groupFd < 0)
+            m_groupFd = fd;
+        m_fds[i] = fd;
+        m_slots[i] = static_cast<int>(m_nbOpened++);
+    }
+
+    if (m_groupFd < 0)
+    {
+        std::cerr << "Hardware counters unavailable (" << strerror(firstError)
+                  << "), check /proc/sys/kernel/perf_event_paranoid" << std::endl;
+        return -1;
+    }
+
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i)
+    {
+        if (m_slots[i] < 0)
+            std::cerr << "Hardware counter " << GetPerfCounterName(static_cast<PerfCounter>(i)) << " unavailable, it will read 0" << std::endl;
+    }
+
+    ioctl(m_groupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return 0;
+#else
+    std::cerr << "Hardware counters are only supported on Linux" << std::endl;
+    return -1;
+#endif // __linux__
+}
+
+void PerfCounters::Close()
+{
+#ifdef __linux__
+    // Members first, the leader last
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i)
+    {
+        if (m_fds[i] >= 0 && m_fds[i] != m_groupFd)
+            close(m_fds[i]);
+    }
+    if (m_groupFd >= 0)
+        close(m_groupFd);
+#endif // __linux__
+    m_groupFd = -1;
+    m_fds.fill(-1);
+    m_slots.fill(-1);
+    m_nbOpened = 0;
+}
+
+void PerfCounters::Read(PerfCounterValues& out) const
+{
+    out.Clear();
+#ifdef __linux__
+    if (m_groupFd < 0)
+        return;
+
+    // PERF_FORMAT_GROUP layout: number of counters, then their values
+    uint64_t buffer[1 + PERF_COUNTER_COUNT];
+    if (read(m_groupFd, buffer, sizeof(buffer)) < static_cast<ssize_t>(sizeof(uint64_t)))
+        return;
+
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; ++i)
+    {
+        if (m_slots[i] >= 0 && static_cast<uint64_t>(m_slots[i]) < buffer[0])
+            out.values[i] = buffer[1 + m_slots[i]];
+    }
+#endif // __linux__
+}
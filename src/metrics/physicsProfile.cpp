@@ -0,0 +1,75 @@
+#include <metrics/physicsProfile.h>
+
+#include <Box2D/Box2D.h>
+
+namespace
+{
+    // Timings from 0.1us to 10s, counts from 1 to 1M
+    constexpr double MIN_TIME_MS = 1e-4;
+    constexpr double MAX_TIME_MS = 1e4;
+    constexpr double MIN_COUNT = 0.5;
+    constexpr double MAX_COUNT = 1e6;
+
+    RollingHistogram CreateTimeHistogram(size_t windowSize)
+    {
+        return RollingHistogram(windowSize, MIN_TIME_MS, MAX_TIME_MS);
+    }
+}
+
+const char* GetPhysicsPhaseName(PhysicsPhase phase)
+{
+    switch (phase)
+    {
+    case PhysicsPhase::Step: return "step";
+    case PhysicsPhase::Collide: return "collide";
+    case PhysicsPhase::Solve: return "solve";
+    case PhysicsPhase::SolveInit: return "solveInit";
+    case PhysicsPhase::SolveVelocity: return "solveVelocity";
+    case PhysicsPhase::SolvePosition: return "solvePosition";
+    case PhysicsPhase::Broadphase: return "broadphase";
+    case PhysicsPhase::SolveTOI: return "solveTOI";
+    default: return "unknown";
+    }
+}
+
+PhysicsProfile::PhysicsProfile(size_t windowSize)
+    : m_phases{
+        CreateTimeHistogram(windowSize), CreateTimeHistogram(windowSize), CreateTimeHistogram(windowSize),
+        CreateTimeHistogram(windowSize), CreateTimeHistogram(windowSize), CreateTimeHistogram(windowSize),
+        CreateTimeHistogram(windowSize), CreateTimeHistogram(windowSize) }
+    , m_contacts(windowSize, MIN_COUNT, MAX_COUNT)
+    , m_islands(windowSize, MIN_COUNT, MAX_COUNT)
+{
+    static_assert(PHYSICS_PHASE_COUNT == 8, "Update the histograms initialization");
+}
+
+void PhysicsProfile::Record(const b2World& world)
+{
+    const b2Profile& profile = world.GetProfile();
+    m_phases[static_cast<size_t>(PhysicsPhase::Step)].Add(profile.step);
+    m_phases[static_cast<size_t>(PhysicsPhase::Collide)].Add(profile.collide);
+    m_phases[static_cast<size_t>(PhysicsPhase::Solve)].Add(profile.solve);
+    m_phases[static_cast<size_t>(PhysicsPhase::SolveInit)].Add(profile.solveInit);
+    m_phases[static_cast<size_t>(PhysicsPhase::SolveVelocity)].Add(profile.solveVelocity);
+    m_phases[static_cast<size_t>(PhysicsPhase::SolvePosition)].Add(profile.solvePosition);
+    m_phases[static_cast<size_t>(PhysicsPhase::Broadphase)].Add(profile.broadphase);
+    m_phases[static_cast<size_t>(PhysicsPhase::SolveTOI)].Add(profile.solveTOI);
+    m_contacts.Add(world.GetContactCount());
+    m_islands.Add(world.GetIslandCount());
+}
+
+size_t PhysicsProfile::GetMemoryUsage() const
+{
+    size_t bytes = m_contacts.GetMemoryUsage() + m_islands.GetMemoryUsage();
+    for (const RollingHistogram& phase : m_phases)
+        bytes += phase.GetMemoryUsage();
+    return bytes;
+}
+
+void PhysicsProfile::Clear()
+{
+    for (RollingHistogram& phase : m_phases)
+        phase.Clear();
+    m_contacts.Clear();
+    m_islands.Clear();
+}
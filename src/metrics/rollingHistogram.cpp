@@ -0,0 +1,97 @@
+#include <metrics/rollingHistogram.h>
+
+#include <algorithm>
+#include <cmath>
+
+RollingHistogram::RollingHistogram(size_t windowSize, double minValue, double maxValue, unsigned int subBuckets)
+    : m_minValue(minValue)
+    , m_subBuckets(std::max(subBuckets, 1u))
+    , m_window(windowSize, 0.0)
+{
+    unsigned int nbBuckets = static_cast<unsigned int>(std::ceil(std::log2(maxValue / minValue) * m_subBuckets)) + 1;
+    m_buckets.resize(nbBuckets, 0);
+}
+
+void RollingHistogram::Add(double value)
+{
+    bool maxLeft = false;
+    if (m_window.empty())
+    {
+        m_count++;
+    }
+    else
+    {
+        // The window is full, the oldest sample leaves
+        if (m_count == m_window.size())
+        {
+            double oldest = m_window[m_next];
+            m_buckets[GetBucket(oldest)]--;
+            m_sum -= oldest;
+            maxLeft = oldest >= m_max;
+        }
+        else
+        {
+            m_count++;
+        }
+        m_window[m_next] = value;
+        m_next = (m_next + 1) % m_window.size();
+    }
+
+    m_buckets[GetBucket(value)]++;
+    m_sum += value;
+
+    if (m_count == 1 || value >= m_max)
+        m_max = value;
+    // Rare: only when the maximum leaves the window, which is full
+    else if (maxLeft)
+        m_max = *std::max_element(m_window.begin(), m_window.end());
+}
+
+void RollingHistogram::Clear()
+{
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_next = 0;
+    m_count = 0;
+    m_sum = 0.0;
+    m_max = 0.0;
+}
+
+double RollingHistogram::GetMean() const
+{
+    return m_count == 0 ? 0.0 : m_sum / m_count;
+}
+
+double RollingHistogram::GetPercentile(double p) const
+{
+    if (m_count == 0)
+        return 0.0;
+
+    // Rank of the sample we are looking for, 1 based
+    size_t rank = static_cast<size_t>(std::ceil(std::clamp(p, 0.0, 1.0) * m_count));
+    rank = std::max<size_t>(rank, 1);
+    size_t seen = 0;
+    for (unsigned int bucket = 0; bucket < m_buckets.size(); ++bucket)
+    {
+        seen += m_buckets[bucket];
+        if (seen >= rank)
+            return GetBucketValue(bucket);
+    }
+    return GetBucketValue(static_cast<unsigned int>(m_buckets.size()) - 1);
+}
+
+unsigned int RollingHistogram::GetBucket(double value) const
+{
+    if (!(value > m_minValue))
+        return 0;
+    unsigned int bucket = static_cast<unsigned int>(std::log2(value / m_minValue) * m_subBuckets) + 1;
+    return std::min(bucket, static_cast<unsigned int>(m_buckets.size()) - 1);
+}
+
+double RollingHistogram::GetBucketValue(unsigned int bucket) const
+{
+    // First bucket holds everything up to minValue, 0 included
+    if (bucket == 0)
+        return 0.0;
+    // Geometric middle of [min * 2^((b-1)/S), min * 2^(b/S)[
+    return m_minValue * std::exp2((bucket - 0.5) / m_subBuckets);
+}
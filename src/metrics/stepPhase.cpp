@@ -0,0 +1,17 @@
+#include <metrics/stepPhase.h>
+
+const char* GetStepPhaseName(StepPhase phase)
+{
+    switch (phase)
+    {
+    case StepPhase::Scenario: return "scenario";
+    case StepPhase::Observations: return "observations";
+    case StepPhase::Controllers: return "controllers";
+    case StepPhase::CarStep: return "carStep";
+    case StepPhase::Physics: return "physics";
+    case StepPhase::Rankings: return "rankings";
+    case StepPhase::Camera: return "camera";
+    case StepPhase::Reset: return "reset";
+    default: return "unknown";
+    }
+}
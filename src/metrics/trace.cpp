@@ -0,0 +1,156 @@
+#include <metrics/trace.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    struct Event
+    {
+        const char* name;
+        int64_t beginNs;
+        int64_t endNs;
+    };
+
+    struct ThreadBuffer
+    {
+        uint32_t threadId = 0;
+        std::string threadName;
+        std::vector<Event> events;
+        uint64_t nbDropped = 0;
+    };
+
+    // Buffers are shared with the registry so they survive their thread
+    std::mutex g_registryLock;
+    std::vector<std::shared_ptr<ThreadBuffer>> g_buffers;
+    uint32_t g_nextThreadId = 1;
+
+    ThreadBuffer& GetThreadBuffer()
+    {
+        thread_local std::shared_ptr<ThreadBuffer> buffer;
+        if (buffer == nullptr)
+        {
+            buffer = std::make_shared<ThreadBuffer>();
+            // Recording never grows the buffer (pages are only touched when used)
+            buffer->events.reserve(Trace::MAX_EVENTS_PER_THREAD);
+            std::lock_guard<std::mutex> lock(g_registryLock);
+            buffer->threadId = g_nextThreadId++;
+            g_buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    void WriteEscaped(std::ostream& stream, const char* str)
+    {
+        for (; *str != '\0'; ++str)
+        {
+            if (*str == '"' || *str == '\\')
+                stream << '\\';
+            stream << *str;
+        }
+    }
+}
+
+void Trace::Enable(bool enable)
+{
+    g_enabled.store(enable, std::memory_order_relaxed);
+}
+
+int64_t Trace::NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Trace::SetThreadName(const char* name)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(g_registryLock);
+    buffer.threadName = name;
+}
+
+void Trace::RecordZone(const char* name, int64_t beginNs, int64_t endNs)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    if (buffer.events.size() >= MAX_EVENTS_PER_THREAD)
+    {
+        buffer.nbDropped++;
+        return;
+    }
+    buffer.events.push_back({ name, beginNs, endNs });
+}
+
+void Trace::Clear()
+{
+    std::lock_guard<std::mutex> lock(g_registryLock);
+    for (auto& buffer : g_buffers)
+    {
+        buffer->events.clear();
+        buffer->nbDropped = 0;
+    }
+}
+
+int Trace::WriteChromeTrace(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        std::cerr << "Failed to open " << path << std::endl;
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(g_registryLock);
+
+    // Timestamps are relative to the first event, in microseconds
+    int64_t origin = INT64_MAX;
+    for (const auto& buffer : g_buffers)
+    {
+        for (const Event& event : buffer->events)
+            origin = std::min(origin, event.beginNs);
+    }
+
+    uint64_t nbEvents = 0;
+    uint64_t nbDropped = 0;
+    bool first = true;
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [" << std::endl;
+    for (const auto& buffer : g_buffers)
+    {
+        if (!buffer->threadName.empty())
+        {
+            file << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+                 << buffer->threadId << ", \"args\": {\"name\": \"";
+            WriteEscaped(file, buffer->threadName.c_str());
+            file << "\"}}";
+            first = false;
+        }
+
+        for (const Event& event : buffer->events)
+        {
+            file << (first ? "" : ",\n") << "{\"name\": \"";
+            WriteEscaped(file, event.name);
+            file << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->threadId
+                 << ", \"ts\": " << (event.beginNs - origin) / 1000.0
+                 << ", \"dur\": " << (event.endNs - event.beginNs) / 1000.0 << "}";
+            first = false;
+        }
+        nbEvents += buffer->events.size();
+        nbDropped += buffer->nbDropped;
+        buffer->events.clear();
+        buffer->nbDropped = 0;
+    }
+    file << std::endl << "]}" << std::endl;
+
+    std::cout << "Trace written to " << path << " (" << nbEvents << " events";
+    if (nbDropped > 0)
+        std::cout << ", " << nbDropped << " dropped";
+    std::cout << ")" << std::endl;
+    return 0;
+}
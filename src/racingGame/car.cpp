@@ -1,8 +1,6 @@
 #include <racingGame/car.h>
 #include <racingGame/constants.h>
 #include <racingGame/controllers/carController.h>
-#include <renderer/renderer.h>
-#include <renderable/polygon.h>
 #include <Box2D/Box2D.h>
 #include <atomic>
 
@@ -13,7 +11,6 @@
 
 void Car::Wheel::Destroy(b2World* world)
 {
-    delete polygon;
     world->DestroyBody(body);
 }
 
@@ -28,11 +25,6 @@ void Car::Hull::Destroy(b2World* world)
         wheel.Destroy(world);
     }
 
-    Renderer* renderer = Renderer::GetInstance();
-    if (renderer != nullptr)
-        renderer->RemoveRenderable(polygon->GetId());
-
-    delete polygon;
     world->DestroyBody(body);
 }
 
@@ -73,7 +65,6 @@ Car::Car(b2World* world, const glm::vec4& color, unsigned int initialTrackIndex,
     m_hull.color = color;
 
     InitializePhysics();
-    InitializeRendering();
     m_lapInfo.InitializeLap(initialTrackIndex, currentTime);
 
     m_isDrifting = false;
@@ -151,30 +142,6 @@ void Car::InitializePhysics()
     }
 }
 
-void Car::InitializeRendering()
-{
-    if (!Renderer::GetInstance()->IsEnabled())
-        return;
-
-    // First the hull
-    std::vector<float> vertices(Constants::HULL_VERTICES);
-    std::vector<unsigned int> indexes(Constants::HULL_INDEXES);
-    m_hull.polygon = new Polygon(vertices, indexes, m_hull.color);
-    m_hull.polygon->GetScale() = glm::vec3(Constants::SCALE_CAR, Constants::SCALE_CAR, 1.0f);
-    Renderer::GetInstance()->AddRenderable(m_hull.polygon);
-
-    // Then the wheels
-    std::vector<unsigned int> indexesWheel = {0, 1, 2, 0, 2, 3};
-    glm::vec4 wheelColor(Constants::WHEEL_COLOR[0], Constants::WHEEL_COLOR[1], Constants::WHEEL_COLOR[2], 1.0f);
-    std::vector<float> verticesWheel(Constants::WHEEL_VERTICES);
-    for(unsigned int i = 0; i < 4; ++i){
-        Polygon* wheel = new Polygon(verticesWheel, indexesWheel, wheelColor);
-        wheel->GetPosition() = glm::vec3(Constants::WHEELPOS[2 * i], Constants::WHEELPOS[2 * i + 1], 0.0f);
-        m_hull.polygon->AddChild(wheel);
-        m_hull.wheels[i].polygon = wheel;
-    }
-}
-
 void Car::SetIntialState(const glm::vec2& pos, float angle, float offset)
 {
     if (m_hull.body == nullptr)
@@ -194,8 +161,6 @@ void Car::SetIntialState(const glm::vec2& pos, float angle, float offset)
     {
         wheel.body->SetTransform(box2DPos + wheel.body->GetPosition(), angle);
     }
-
-    UpdateRendering();
 }
 
 glm::vec2 Car::GetPosition() const
@@ -221,21 +186,6 @@ float Car::GetAngle() const
     return m_hull.body->GetAngle();
 }
 
-void Car::UpdateRendering()
-{
-    if (m_hull.polygon == nullptr || m_hull.body == nullptr)
-        return;
-    
-    glm::vec2 pos = GetPosition();
-    m_hull.polygon->GetPosition() = glm::vec3(pos.x, pos.y, 0.0f);
-    m_hull.polygon->GetRotation()[2] = GetAngle();
-
-    for (auto& wheel : m_hull.wheels)
-    {
-        wheel.polygon->GetRotation()[2] = wheel.body->GetAngle() - m_hull.polygon->GetRotation()[2];
-    }
-}
-
 void Car::Gas(float gas)
 {
     gas = std::clamp(gas, 0.0f, 1.0f);
@@ -406,3 +356,8 @@ void Car::EnableCollision(bool enable)
         }
     }
 }
+
+size_t Car::GetMemoryUsage() const
+{
+    return sizeof(Car) + m_hull.wheels.capacity() * sizeof(Wheel);
+}
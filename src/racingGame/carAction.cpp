@@ -0,0 +1,9 @@
+#include <racingGame/carAction.h>
+#include <racingGame/car.h>
+
+void CarAction::Apply(Car& car) const
+{
+    car.Gas(gas);
+    car.Brake(brake);
+    car.Steer(steer);
+}
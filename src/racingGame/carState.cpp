@@ -3,7 +3,9 @@
 #include <racingGame/track.h>
 #include <utils/utils.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <sstream>
 #include <debugManager/debugManager.h>
 
@@ -14,6 +16,14 @@
 
 CarState CarState::GenerateState(const Car& car, const Track::Path& path, unsigned int currentIndex, 
     bool addDebugInfo, unsigned int carId, const std::unordered_map<unsigned int, Car*>& allCars)
+{
+    CarState state;
+    GenerateState(car, path, currentIndex, addDebugInfo, carId, allCars, state);
+    return state;
+}
+
+void CarState::GenerateState(const Car& car, const Track::Path& path, unsigned int currentIndex,
+    bool addDebugInfo, unsigned int carId, const std::unordered_map<unsigned int, Car*>& allCars, CarState& state)
 {
     bool reverse = car.GetIsReverse();
 
@@ -30,15 +40,19 @@ CarState CarState::GenerateState(const Car& car, const Track::Path& path, unsign
         return static_cast<size_t>(res);
     };
 
-    CarState state;
+    // Reset everything but the opponents buffer
+    std::vector<OpponentCar> opponents = std::move(state.opponentsOrdered);
+    opponents.clear();
+    state = CarState();
+    state.opponentsOrdered = std::move(opponents);
 
     const b2Body* hull = car.GetHull().body;
     if (hull == nullptr)
-        return state;
+        return;
 
     const std::vector<Car::Wheel>& wheels = car.GetHull().wheels;
     if (wheels.size() != 4)
-        return state;
+        return;
 
     glm::vec2 carPosition = Utils::Convertb2Toglm(hull->GetPosition());
     glm::vec2 carVelocity = Utils::Convertb2Toglm(hull->GetLinearVelocity());
@@ -145,16 +159,36 @@ CarState CarState::GenerateState(const Car& car, const Track::Path& path, unsign
         opponentCar.forward = Utils::Convertb2Toglm(otherHull->GetWorldVector(b2Vec2(0.0f, 1.0f)));
         opponentCar.distance = glm::length(carPosition - opponentCar.position);
 
-        state.opponentsOrdered.emplace(std::move(opponentCar));
+        state.opponentsOrdered.push_back(opponentCar);
     }
+    std::sort(state.opponentsOrdered.begin(), state.opponentsOrdered.end());
 
     if (addDebugInfo)
     {
         DebugManager* debugManager = DebugManager::GetInstance();
         constexpr unsigned int frametime = 5;
-        std::stringstream buffer;
-        buffer << "distance_" << carId;
-        debugManager->DrawLine(buffer.str().c_str(), carPosition, projectionOnRoad, Colors::BLUE, frametime);
+        // Names interned once, the car id is the index of the key
+        struct DebugIds
+        {
+            DebugManager::DebugId distance;
+            std::array<DebugManager::DebugId, SamplingIndexes::SAMPLING_INDEXES_SIZE> offsetV;
+            std::array<DebugManager::DebugId, SamplingIndexes::SAMPLING_INDEXES_SIZE> offsetH;
+        };
+        static const DebugIds ids = []()
+        {
+            DebugIds result;
+            result.distance = DebugManager::Intern("distance");
+            char buffer[32];
+            for (unsigned int i = 0; i < SamplingIndexes::SAMPLING_INDEXES_SIZE; ++i)
+            {
+                snprintf(buffer, sizeof(buffer), "offsetv_%.2gm", SamplingIndexes::SAMPLING_DISTANCES[i]);
+                result.offsetV[i] = DebugManager::Intern(buffer);
+                snprintf(buffer, sizeof(buffer), "offseth_%.2gm", SamplingIndexes::SAMPLING_DISTANCES[i]);
+                result.offsetH[i] = DebugManager::Intern(buffer);
+            }
+            return result;
+        }();
+        debugManager->DrawLine(DebugManager::MakeKey(ids.distance, carId), carPosition, projectionOnRoad, Colors::BLUE, frametime);
 
         std::array<Colors, SamplingIndexes::SAMPLING_INDEXES_SIZE> colors = {
             Colors::RED,
@@ -166,20 +200,29 @@ CarState CarState::GenerateState(const Car& car, const Track::Path& path, unsign
 
         for (unsigned int i = 0; i < SamplingIndexes::SAMPLING_INDEXES_SIZE; ++i)
         {
-            std::stringstream buffer1;
-            std::stringstream buffer2;
-            buffer1.precision(2);
-            buffer2.precision(2);
-            buffer1 << "offsetv_" << SamplingIndexes::SAMPLING_DISTANCES[i] << "m_" << carId;
-            buffer2 << "offseth_" << SamplingIndexes::SAMPLING_DISTANCES[i] << "m_" << carId;
             firstPoint = carPosition + carForward * state.pointsFurther[2 * i] * state.debugPointsFurtherDistances[i];
             secondPoint = firstPoint + carSide * state.pointsFurther[2 * i + 1] * state.debugPointsFurtherDistances[i];
-            debugManager->DrawLine(buffer1.str().c_str(), carPosition, firstPoint, colors[i], frametime);
-            debugManager->DrawLine(buffer2.str().c_str(), firstPoint, secondPoint, colors[i], frametime);
+            debugManager->DrawLine(DebugManager::MakeKey(ids.offsetV[i], carId), carPosition, firstPoint, colors[i], frametime);
+            debugManager->DrawLine(DebugManager::MakeKey(ids.offsetH[i], carId), firstPoint, secondPoint, colors[i], frametime);
         }
     }
+}
 
-    return state;
+void CarState::Flatten(float* out) const
+{
+    size_t i = 0;
+    out[i++] = distanceFromRoad;
+    out[i++] = carVelocityRoadRef[0];
+    out[i++] = carVelocityRoadRef[1];
+    out[i++] = angleWithRoad;
+    out[i++] = wheelAngles[0];
+    out[i++] = wheelAngles[1];
+    for (float omega : wheelOmegas)
+        out[i++] = omega;
+    out[i++] = carOmega;
+    out[i++] = driftAngle;
+    for (float point : pointsFurther)
+        out[i++] = point;
 }
 
 std::string CarState::ToString()
@@ -0,0 +1,35 @@
+#include <racingGame/controllers/cruiseCarController.h>
+#include <racingGame/car.h>
+#include <racingGame/carState.h>
+
+#include <algorithm>
+
+namespace
+{
+    // Speed along the road, in CarState::MAX_SPEED. Faster, the cars miss the sharp corners
+    constexpr float CRUISE_SPEED = 0.75f;
+    // Brakes only that much over the cruise speed, coasts in between
+    constexpr float BRAKE_MARGIN = 0.2f;
+    constexpr float GAS = 0.3f;
+    constexpr float BRAKE = 0.3f;
+    // Sampled point steered toward (10m ahead), see SamplingIndexes::SAMPLING_DISTANCES.
+    // Closer the car oscillates, further it cuts the corners
+    constexpr size_t TARGET_POINT = 2;
+}
+
+CruiseCarController::CruiseCarController()
+    : CarController(Constants::STATE_INTERVAL)
+{
+}
+
+void CruiseCarController::Update(const CarState& state, Car& car)
+{
+    const float speed = state.carVelocityRoadRef[0];
+    car.Gas(speed < CRUISE_SPEED ? GAS : 0.0f);
+    car.Brake(speed > CRUISE_SPEED + BRAKE_MARGIN ? BRAKE : 0.0f);
+
+    // Side component of the point in the car reference (pointsFurther[2 * i] is the forward one).
+    // A point on the positive side needs a negative steer
+    const float side = state.pointsFurther[2 * TARGET_POINT + 1];
+    car.Steer(std::clamp(-side, -1.0f, 1.0f));
+}
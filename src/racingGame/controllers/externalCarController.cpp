@@ -0,0 +1,7 @@
+#include <racingGame/controllers/externalCarController.h>
+#include <racingGame/car.h>
+
+void ExternalCarController::Update(const CarState&, Car& car)
+{
+    m_action.Apply(car);
+}
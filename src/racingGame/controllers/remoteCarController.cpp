@@ -0,0 +1,44 @@
+#include <racingGame/controllers/remoteCarController.h>
+#include <racingGame/carState.h>
+#include <racingGame/carAction.h>
+#include <racingGame/car.h>
+
+RemoteInferenceBatch::RemoteInferenceBatch(const std::string& socketPath)
+    : m_client(socketPath)
+{
+    m_client.Connect();
+}
+
+void RemoteInferenceBatch::Queue(const CarState& state, Car& car)
+{
+    if (!m_client.IsConnected())
+        return;
+
+    m_cars.push_back(&car);
+    m_states.resize(m_states.size() + CarState::FLAT_SIZE);
+    state.Flatten(m_states.data() + m_states.size() - CarState::FLAT_SIZE);
+}
+
+void RemoteInferenceBatch::Flush()
+{
+    const uint32_t count = static_cast<uint32_t>(m_cars.size());
+    m_actions.resize(static_cast<size_t>(count) * CarAction::FLAT_SIZE);
+    if (count > 0 && m_client.InferBatch(m_states.data(), CarState::FLAT_SIZE, m_actions.data(), CarAction::FLAT_SIZE, count))
+    {
+        for (uint32_t i = 0; i < count; ++i)
+            CarAction::FromFlat(m_actions.data() + static_cast<size_t>(i) * CarAction::FLAT_SIZE).Apply(*m_cars[i]);
+    }
+    m_cars.clear();
+    m_states.clear();
+}
+
+RemoteCarController::RemoteCarController(unsigned int stateInterval, RemoteInferenceBatch& batch)
+    : CarController(stateInterval)
+    , m_batch(batch)
+{
+}
+
+void RemoteCarController::Update(const CarState& state, Car& car)
+{
+    m_batch.Queue(state, car);
+}
@@ -4,37 +4,44 @@
 #include <Box2D/Box2D.h>
 #include <racingGame/track.h>
 
-#include <renderer/renderer.h>
-#include <renderer/camera.h>
 #include <racingGame/constants.h>
 #include <racingGame/carState.h>
-#include <racingGame/controllers/humanCarController.h>
+#include <racingGame/controllers/carController.h>
+#include <racingGame/gameView.h>
+#include <racingGame/pipelinedGameView.h>
 #include <racingGame/scenarios/scenario.h>
+#include <racingGame/scenarios/spawningStrategy.h>
 
+#include <algorithm>
 #include <iostream>
 #include <chrono> 
 #include <thread>
 #include <numeric>
-#include <GLFW/glfw3.h>
 #include <debugManager/debugManager.h>
+#include <metrics/trace.h>
+#include <utils/randomEngine.h>
 #include <utils/utils.h>
-#include <shaders/shaderManager.h>
-
-#define PROFILING
 
 namespace
 {
+    // Given to the controllers that don't require a state
+    const CarState EMPTY_STATE{};
+    // Render thread sleep when no new frame was published
+    constexpr int64_t RENDER_THREAD_IDLE_US = 500;
+
     const GameConfig& GetGameConfig()
     {
         return GameConfigSingleton::GetInstance()->m_gameConfig;
     }
 }
 
-GameManager::GameManager(const GameConfig& config, Scenario* scenario)
+GameManager::GameManager(const GameConfig& config, Scenario* scenario, GameView* view)
     : m_initialGameConfig(config)
     , m_scenario(scenario)
+    , m_view(view)
 {
-
+    m_quality.velocityIterations = Constants::VELOCITY_ITERATIONS;
+    m_quality.positionIterations = Constants::POSITION_ITERATIONS;
 }
 
 GameManager::~GameManager()
@@ -62,7 +69,7 @@ int GameManager::Initialize()
     m_world = new b2World(b2Vec2(0.0f, 0.0f));
     m_track = new Track();
 
-    DebugManager::GetInstance()->Enable(true);
+    DebugManager::GetInstance()->Enable(m_view != nullptr && m_view->IsEnabled());
 
     if (m_scenario != nullptr)
         return m_scenario->Initialize();
@@ -75,9 +82,12 @@ void GameManager::ClearCars()
     {
         if (m_scenario != nullptr)
             m_scenario->OnVehicleUnspawned(it.second);
+        if (m_view != nullptr)
+            m_view->OnVehicleUnspawned(*it.second);
         delete it.second;
     }
     m_cars.clear();
+    m_raceRanking.clear();
 }
 
 void GameManager::Reset()
@@ -85,12 +95,15 @@ void GameManager::Reset()
     if (m_world == nullptr || m_track == nullptr)
         return;
 
-    Renderer* renderer = Renderer::GetInstance();
-    renderer->ClearInputCallbacks();
+    if (m_view != nullptr)
+        m_view->OnReset();
 
     ClearCars();
     m_track->ClearTrack();
     while(!m_track->GenerateTrack());
+
+    if (m_view != nullptr)
+        m_view->OnTrackGenerated(*m_track);
 }
 
 const Car::LapInfo* GameManager::GetLapInfoFromId(unsigned int id) const
@@ -111,6 +124,41 @@ void GameManager::GetCarsIndexOnTrack(std::vector<unsigned int>& outVector) cons
     }
 }
 
+void GameManager::AddMemoryUsage(MemoryReport& report) const
+{
+    // Metrics histograms and quality settings are part of the object
+    report.Add("game", sizeof(GameManager) + m_raceRanking.capacity() * sizeof(const Car*) +
+        m_dueControllers.capacity() * sizeof(DueController) + m_carStates.capacity() * sizeof(CarState) +
+        m_cars.bucket_count() * sizeof(void*) + m_cars.size() * (sizeof(std::pair<const unsigned int, Car*>) + sizeof(void*)));
+
+    size_t opponentsBytes = 0;
+    for (const CarState& state : m_carStates)
+        opponentsBytes += state.opponentsOrdered.capacity() * sizeof(OpponentCar);
+    report.Add("game/states", opponentsBytes);
+
+    report.Add("metrics", m_physicsProfile.GetMemoryUsage() + m_frameTimeMonitor.GetFrameTimes().GetMemoryUsage() +
+        m_budgetGovernor.GetMemoryUsage());
+
+    if (m_world != nullptr)
+    {
+        // The stack allocator is an array inside the world, see GetStackAllocatorPeak for its use
+        report.Add("box2d/world", sizeof(b2World) - b2_stackSize);
+        report.Add("box2d/stackAllocator", b2_stackSize);
+        report.Add("box2d/blockAllocator", static_cast<size_t>(m_world->GetBlockAllocatorBytes()),
+            static_cast<size_t>(m_world->GetBodyCount() + m_world->GetContactCount() + m_world->GetJointCount()));
+        report.Add("box2d/broadPhase", static_cast<size_t>(m_world->GetBroadPhaseBytes()), static_cast<size_t>(m_world->GetProxyCount()));
+    }
+
+    for (const auto& it : m_cars)
+        report.Add("cars", it.second->GetMemoryUsage());
+
+    if (m_track != nullptr)
+        report.Add("track", m_track->GetMemoryUsage());
+
+    if (m_view != nullptr)
+        m_view->AddMemoryUsage(report);
+}
+
 void GameManager::UpdateCarsRanking()
 {
     if (!GetGameConfig().computeRankings)
@@ -135,43 +183,52 @@ float GameManager::GetElapsedTime() const
 
 void GameManager::UpdateCamera()
 {
-    if (m_cars.empty())
+    if (m_cars.empty() || m_view == nullptr)
         return;
-    Camera& camera = Renderer::GetInstance()->GetCamera();
 
     Car* firstCar = m_cars.begin()->second;
 
     // Get the current angle and store it in our buffer
     m_smoothCameraRotation.push_back(firstCar->GetAngle());
-    float angle = std::accumulate(m_smoothCameraRotation.buffer.begin(), m_smoothCameraRotation.buffer.end(), 0.0f) / m_smoothCameraRotation.size();
-    // Set the rotation with the up vector
-    glm::vec3 up(glm::vec3(-std::sin(angle), std::cos(angle), 0.0f));
-    camera.SetUp(up);
-
-    // Snap the camera to the car, minus an offset, to see more of the road
-    glm::vec2 pos = firstCar->GetPosition();
-    glm::vec3 cameraNewPos(pos[0], pos[1], camera.GetPosition()[2]);
-    cameraNewPos[2] = camera.GetPosition()[2];
-    cameraNewPos += up * 10.0f;
-    camera.SetPosition(cameraNewPos);
+    float angle = firstCar->GetAngle();
+    if (m_quality.cameraSmoothing)
+        angle = std::accumulate(m_smoothCameraRotation.buffer.begin(), m_smoothCameraRotation.buffer.end(), 0.0f) / m_smoothCameraRotation.size();
+    m_view->UpdateCamera(firstCar->GetPosition(), angle);
+}
+
+void GameManager::ApplyQualitySettings(const QualitySettings& settings)
+{
+    m_quality = settings;
+    // Disabling also clears the lines already there
+    DebugManager::GetInstance()->Enable(m_view != nullptr && m_view->IsEnabled() && m_quality.debugLines);
 }
 
 void GameManager::CreateSingletons()
 {
-    Renderer::CreateInstance();
+    std::lock_guard<std::mutex> lock(ms_singletonsLock);
+    if (m_holdsSingletons)
+        return;
+    m_holdsSingletons = true;
+    if (ms_nbSingletonsUsers++ > 0)
+        return;
+
     DebugManager::CreateInstance();
     RandomEngine::CreateInstance();
-    ShaderManager::CreateInstance();
     GameConfigSingleton::CreateInstance();
 }
 
 void GameManager::DestroySingletons()
 {
+    std::lock_guard<std::mutex> lock(ms_singletonsLock);
+    if (!m_holdsSingletons)
+        return;
+    m_holdsSingletons = false;
+    if (--ms_nbSingletonsUsers > 0)
+        return;
+
     GameConfigSingleton::DestroyInstance();
-    ShaderManager::DestroyInstance();
     RandomEngine::DestroyInstance();
     DebugManager::DestroyInstance();
-    Renderer::DestroyInstance();
 }
 
 void GameManager::Step(float dt) 
@@ -180,7 +237,26 @@ void GameManager::Step(float dt)
     if (m_scenario == nullptr)
         return;
 
-    m_scenario->Update(*this);
+    FrameTimings* timings = nullptr;
+    int64_t frameStart = 0;
+    PerfCounterValues frameStartCounters;
+    AllocationCounts frameStartAllocations;
+    if (m_frameTimingsEnabled)
+    {
+        timings = &m_frameTimings;
+        timings->Clear();
+        if (timings->counters != nullptr)
+            timings->counters->Read(frameStartCounters);
+        frameStartAllocations = AllocationCounter::Get();
+        frameStart = FrameTimings::NowNs();
+    }
+
+    TRACE_ZONE("GameManager::Step");
+    {
+        PhaseScope scope(timings, StepPhase::Scenario);
+        TRACE_ZONE("Scenario::Update");
+        m_scenario->Update(*this);
+    }
 
     bool shouldReset = false;
     unsigned int i = 0;
@@ -194,59 +270,166 @@ void GameManager::Step(float dt)
         realDt *= config.speed;
 
     // Don't update the physics if we are on pause
-    if (!Renderer::GetInstance()->paused)
+    if (m_view == nullptr || !m_view->IsPaused())
     {
-        for (auto it : m_cars)
+        // Each phase runs over all the cars in one scope: with perf counters on, a scope reads
+        // them twice, per car that would cost as much as the work measured
         {
-            Car* car = it.second;
-            // Check if the car is out
-            const glm::vec2& carPos = car->GetPosition();
-            if (std::abs(carPos[0]) > 0.85f * Constants::PLAYFIELD ||
-                std::abs(carPos[1]) > 0.85f * Constants::PLAYFIELD)
+            PhaseScope scope(timings, StepPhase::CarStep);
+            m_dueControllers.clear();
+            for (const auto& it : m_cars)
             {
-                shouldReset = true;
-                break;
+                Car* car = it.second;
+                // Check if the car is out
+                const glm::vec2& carPos = car->GetPosition();
+                if (std::abs(carPos[0]) > 0.85f * Constants::PLAYFIELD ||
+                    std::abs(carPos[1]) > 0.85f * Constants::PLAYFIELD)
+                {
+                    shouldReset = true;
+                    break;
+                }
+
+                car->UpdateTrackIndex(m_track->GetPath(), elapsedTime);
+
+                CarController* controller = car->GetController();
+                if (controller != nullptr)
+                {
+                    // Slow down if the speed is below 1
+                    // Speed up is not supported for now
+                    unsigned int stateInterval = controller->GetStateInterval();
+                    if (config.speed < 1.0f)
+                        stateInterval = static_cast<unsigned int>(std::floor(stateInterval / config.speed));
+                    if (m_nbFrames % stateInterval == 0)
+                        m_dueControllers.push_back({ car, controller, i });
+                }
+                ++i;
             }
+        }
+
+        // The world is reset at the end of the frame, its cars are not controlled anymore
+        if (shouldReset)
+            m_dueControllers.clear();
 
-            car->UpdateTrackIndex(m_track->GetPath(), elapsedTime);
-            CarController* controller = car->GetController();
-            // Slow down if the speed is below 1
-            // Speed up is not supported for now
-            unsigned int stateInterval = controller->GetStateInterval();
-            if (config.speed < 1.0f)
-                stateInterval = static_cast<unsigned int>(std::floor(stateInterval / config.speed));
-            if (controller != nullptr && m_nbFrames % stateInterval == 0)
+        // A state per controlled car, all generated before the controllers run. The cars only
+        // move in the world step, so they are the same as generated right before each controller
+        if (m_carStates.size() < m_dueControllers.size())
+            m_carStates.resize(m_dueControllers.size());
+        {
+            PhaseScope scope(timings, StepPhase::Observations);
+            for (size_t k = 0; k < m_dueControllers.size(); ++k)
             {
-                CarState state = CarState::GenerateState(*car, m_track->GetPath(), car->GetCurrentTrackIndex(), config.debugInfo, i, m_cars);
-                controller->Update(state, *car);
+                const DueController& due = m_dueControllers[k];
+                if (!due.controller->RequiresState())
+                    continue;
+                TRACE_ZONE("CarState::GenerateState");
+                CarState::GenerateState(*due.car, m_track->GetPath(), due.car->GetCurrentTrackIndex(), config.debugInfo && m_quality.debugLines,
+                    due.carIndex, m_cars, m_carStates[k]);
             }
+        }
 
-            car->Step(realDt);
-            car->UpdateRendering();
+        {
+            PhaseScope scope(timings, StepPhase::Controllers);
+            for (size_t k = 0; k < m_dueControllers.size(); ++k)
+            {
+                const DueController& due = m_dueControllers[k];
+                TRACE_ZONE("CarController::Update");
+                due.controller->Update(due.controller->RequiresState() ? m_carStates[k] : EMPTY_STATE, *due.car);
+            }
+            if (!m_dueControllers.empty())
+            {
+                TRACE_ZONE("Scenario::OnControllersUpdated");
+                m_scenario->OnControllersUpdated();
+            }
         }
 
-        m_world->Step(realDt, 6 * 30, 2 * 30);
+        if (!shouldReset)
+        {
+            PhaseScope scope(timings, StepPhase::CarStep);
+            for (const auto& it : m_cars)
+            {
+                TRACE_ZONE("Car::Step");
+                it.second->Step(realDt);
+            }
+        }
 
-        UpdateCarsRanking();
+        {
+            PhaseScope scope(timings, StepPhase::Physics);
+            TRACE_ZONE("b2World::Step");
+            m_world->Step(realDt, m_quality.velocityIterations, m_quality.positionIterations);
+        }
+        if (timings != nullptr)
+            m_physicsProfile.Record(*m_world);
+
+        if (m_nbFrames % m_quality.rankingInterval == 0)
+        {
+            PhaseScope scope(timings, StepPhase::Rankings);
+            TRACE_ZONE("GameManager::UpdateCarsRanking");
+            UpdateCarsRanking();
+        }
     }
 
-    if (config.attachCamera)
+    if (config.attachCamera && m_view != nullptr && m_view->IsEnabled())
+    {
+        PhaseScope scope(timings, StepPhase::Camera);
+        TRACE_ZONE("GameManager::UpdateCamera");
         UpdateCamera();
+    }
 
     if (shouldReset)
+    {
+        PhaseScope scope(timings, StepPhase::Reset);
+        TRACE_ZONE("GameManager::Reset");
         Reset();
+    }
+
+    if (timings != nullptr)
+    {
+        timings->totalNs = FrameTimings::NowNs() - frameStart;
+        timings->totalAllocations.AddDelta(frameStartAllocations, AllocationCounter::Get());
+        if (timings->counters != nullptr)
+        {
+            PerfCounterValues frameEndCounters;
+            timings->counters->Read(frameEndCounters);
+            timings->totalCounters.AddDelta(frameStartCounters, frameEndCounters);
+        }
+    }
 
     m_nbFrames++;
 };
 
+int GameManager::EnablePerfCounters(bool enable)
+{
+    m_frameTimings.counters = nullptr;
+    if (!enable)
+    {
+        m_perfCounters.reset();
+        return 0;
+    }
+
+    if (m_perfCounters == nullptr)
+    {
+        auto counters = std::make_unique<PerfCounters>();
+        int errorCode = counters->Initialize();
+        if (errorCode != 0)
+            return errorCode;
+        m_perfCounters = std::move(counters);
+    }
+    m_frameTimings.counters = m_perfCounters.get();
+    return 0;
+}
+
 void GameManager::SpawnVehicle(unsigned int trackIndex, bool reverse, float offset)
 {
     Car* car = new Car(m_world, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), trackIndex, reverse, GetElapsedTime());
     car->SetIntialState(m_track->GetPath()[trackIndex], m_track->GetAngle(trackIndex, reverse), offset);
     m_cars.emplace(car->GetId(), car);
+    m_raceRanking.push_back(car);
+    m_frameTimings.nbSpawns++;
 
     if (m_scenario != nullptr)
         m_scenario->OnVehicleSpawned(car);
+    if (m_view != nullptr)
+        m_view->OnVehicleSpawned(*car);
 }
 
 void GameManager::UnspawnVehicle(unsigned int id)
@@ -262,12 +445,14 @@ void GameManager::UnspawnVehicle(unsigned int id)
         m_smoothCameraRotation.clear();
         if (m_scenario != nullptr)
             m_scenario->OnVehicleUnspawned(it->second);
+        if (m_view != nullptr)
+            m_view->OnVehicleUnspawned(*it->second);
         delete it->second;
+        m_cars.erase(it);
     }
-    m_cars.erase(it);
 }
 
-int GameManager::Run()
+int GameManager::Setup()
 {
     CreateSingletons();
 
@@ -275,25 +460,14 @@ int GameManager::Run()
 
     const GameConfig& config = GetGameConfig();
 
-    // Initialize the renderer
-    Renderer* renderer = Renderer::GetInstance();
-    renderer->Enable(config.enableRendering);
-    int errorCode = renderer->Initialize(config.windowWidth, config.windowHeight);
-    if (errorCode != 0)
-        return errorCode;
-
-    // Setup the camera
-    Camera& camera = renderer->GetCamera();
-    camera.SetIsOrthographic();
-    camera.SetPosition(glm::vec3(0.0f, 0.0f, -1.0f));
-    camera.SetDirection(glm::vec3(0.0f, 0.0f, 1.0f));
-    camera.SetUp(glm::vec3(0.0f, 1.0f, 0.0f));
-    Camera::OrthographicParams& params = camera.GetOrthographicParams();
-    // Setup differently if we are attached or not to a car
-    if (config.attachCamera)
-        params = { -30.0f, 30.0f, -30.0f, 30.0f, -0.1f, 10.0f };
-    else
-        params = { -200.0f, 200.0f, -200.0f, 200.0f, -0.1f, 10.0f };
+    // Initialize the view, if any
+    int errorCode = 0;
+    if (m_view != nullptr)
+    {
+        errorCode = m_view->Initialize(config);
+        if (errorCode != 0)
+            return errorCode;
+    }
 
     // Then initialize the game
     errorCode = Initialize();
@@ -302,61 +476,139 @@ int GameManager::Run()
     // CHANGE WITH AI CONTROLLERS
     SetNumberOfPlayers(config.humanPlay ? 1 : 1);
     Reset();
+    return 0;
+}
 
-#ifdef PROFILING
-    int64_t count = 0;
-    int64_t sumTimeRendering = 0;
-    int64_t sumTimePhysics = 0;
-#endif // PROFILING
-
-    while (!renderer->IsEnabled() || !renderer->RequestedClose())
-    {
-        auto lastTickTime = std::chrono::high_resolution_clock::now();
+void GameManager::EndFrame(int64_t frameNs, int64_t simulationNs, int64_t renderNs, int64_t frameBudgetNs, bool adaptiveQuality)
+{
+    m_frameTimeMonitor.Record(frameNs, m_frameTimings, renderNs);
+    if (adaptiveQuality && m_budgetGovernor.Update(frameNs))
+        ApplyQualitySettings(m_budgetGovernor.GetSettings());
+    if (simulationNs < frameBudgetNs)
+        std::this_thread::sleep_for(std::chrono::nanoseconds(frameBudgetNs - simulationNs));
+}
 
-#ifdef PROFILING
-        auto tickTimePhysics = std::chrono::high_resolution_clock::now();
-#endif // PROFILING
+void GameManager::RunPipelined(int64_t frameBudgetNs, bool adaptiveQuality)
+{
+    const GameConfig& config = GetGameConfig();
 
-        Step(config.GetDt());
+    // From now on the game only talks to the pipeline, the view belongs to this thread
+    GameView* target = m_view;
+    PipelinedGameView pipeline(target);
+    m_view = &pipeline;
 
-#ifdef PROFILING
-        auto differencePhysics = std::chrono::high_resolution_clock::now() - tickTimePhysics;
-        sumTimePhysics += std::chrono::duration_cast<std::chrono::microseconds>(differencePhysics).count();
-#endif // PROFILING
+    // The generator and the spawning state are per thread, the simulation continues with
+    // the ones of this thread (seeded runs stay deterministic)
+    std::default_random_engine& generator = RandomEngine::GetInstance()->GetGenerator();
+    SpawningStrategy::ThreadState spawningState = SpawningStrategy::GetThreadState();
 
-        if (config.enableRendering)
+    std::thread simulation([&]()
+    {
+        Trace::SetThreadName("Simulation");
+        RandomEngine::ScopedGenerator scopedGenerator(generator);
+        SpawningStrategy::SetThreadState(spawningState);
+        while (!pipeline.RequestedClose())
         {
-            DebugManager::GetInstance()->Update();
-            renderer->ProcessInput();
-            renderer->Render();
+            int64_t frameStart = FrameTimings::NowNs();
+            {
+                TRACE_ZONE("Frame");
+                Step(config.GetDt());
+
+                {
+                    TRACE_ZONE("DebugManager::Update");
+                    DebugManager::GetInstance()->Update(pipeline.IsPaused());
+                }
+                pipeline.Render(*this);
+            }
+            // The frame is shown once both threads are done with it: an over budget
+            // renderer counts in the monitor and the governor like a slow step
+            int64_t simulationNs = FrameTimings::NowNs() - frameStart;
+            int64_t renderNs = pipeline.GetLastRenderNs();
+            EndFrame(std::max(simulationNs, renderNs), simulationNs, renderNs, frameBudgetNs, adaptiveQuality);
         }
+        spawningState = SpawningStrategy::GetThreadState();
+    });
+
+    while (!pipeline.RequestedClose())
+    {
+        // Nothing new, do not spin while the simulation is slower than the display
+        if (!pipeline.RenderLatest())
+            std::this_thread::sleep_for(std::chrono::microseconds(RENDER_THREAD_IDLE_US));
+    }
+    simulation.join();
+    SpawningStrategy::SetThreadState(spawningState);
+    m_view = target;
+
+    std::cout << "Render thread drew " << pipeline.GetNbRendered() << " of " << pipeline.GetNbPublished() << " simulated frames" << std::endl;
+}
 
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        auto difference = currentTime - lastTickTime;
-        auto renderTime = std::chrono::duration_cast<std::chrono::microseconds>(difference).count();
+int GameManager::Run()
+{
+    int errorCode = Setup();
+    if (errorCode != 0)
+        return errorCode;
+
+    const GameConfig& config = GetGameConfig();
+    const bool rendering = m_view != nullptr && m_view->IsEnabled();
+    const int64_t frameBudgetNs = static_cast<int64_t>(floorf(1000000000.0f / config.fps));
+
+    // Phases are timed to tell what caused the frames over budget
+    if (rendering)
+    {
+        EnableFrameTimings(true);
+        m_frameTimeMonitor.SetBudget(frameBudgetNs);
+    }
+    const bool adaptiveQuality = rendering && config.adaptiveQuality;
+    if (adaptiveQuality)
+    {
+        BudgetGovernor::Config governorConfig;
+        governorConfig.budgetNs = frameBudgetNs;
+        governorConfig.maxVelocityIterations = Constants::VELOCITY_ITERATIONS;
+        governorConfig.maxPositionIterations = Constants::POSITION_ITERATIONS;
+        m_budgetGovernor.Configure(governorConfig);
+    }
+
+    const bool pipelined = rendering && config.renderThread && !config.humanPlay && m_view->SupportsSnapshots();
+    if (rendering && config.renderThread && !pipelined)
+        std::cout << "No render thread with human play or a view without snapshots, rendering on the simulation thread" << std::endl;
+
+    if (pipelined)
+        RunPipelined(frameBudgetNs, adaptiveQuality);
+
+    while (!pipelined && (!rendering || !m_view->RequestedClose()))
+    {
+        int64_t frameStart = FrameTimings::NowNs();
+        int64_t renderStart = frameStart;
 
-#ifdef PROFILING
-        sumTimeRendering += renderTime;
-        if (++count == 60)
         {
-            if (config.enableRendering)
-                std::cout << "Mean render time: " << sumTimeRendering / 60 << "us" << std::endl;
-            std::cout << "Mean physics time: " << sumTimePhysics / 60 << "us" << std::endl;
-            count = 0;
-            sumTimePhysics = 0;
-            sumTimeRendering = 0;
+            TRACE_ZONE("Frame");
+            Step(config.GetDt());
+
+            if (rendering)
+            {
+                renderStart = FrameTimings::NowNs();
+                {
+                    TRACE_ZONE("DebugManager::Update");
+                    DebugManager::GetInstance()->Update(m_view->IsPaused());
+                }
+                m_view->ProcessInput();
+                TRACE_ZONE("GameView::Render");
+                m_view->Render(*this);
+            }
         }
-#endif // PROFILING
+
         // Do not wait if we don't render
-        if (config.enableRendering)
+        if (rendering)
         {
-            int64_t deltaTimeUS = static_cast<int64_t>(floorf(1000000.0f / config.fps));
-            if (renderTime < deltaTimeUS)
-                std::this_thread::sleep_for(std::chrono::microseconds(deltaTimeUS - renderTime));
-            else
-                std::cout << "This frame took too much time... " << renderTime << "us" << std::endl;
+            int64_t frameEnd = FrameTimings::NowNs();
+            EndFrame(frameEnd - frameStart, frameEnd - frameStart, frameEnd - renderStart, frameBudgetNs, adaptiveQuality);
         }
     }
-    renderer->Close();
+    if (rendering)
+        m_frameTimeMonitor.PrintSummary(std::cout);
+    if (adaptiveQuality)
+        m_budgetGovernor.PrintSummary(std::cout);
+    if (m_view != nullptr)
+        m_view->Close();
     return 0;
 }
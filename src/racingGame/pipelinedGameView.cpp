@@ -0,0 +1,78 @@
+#include <racingGame/pipelinedGameView.h>
+
+#include <metrics/frameTimings.h>
+#include <metrics/memoryReport.h>
+#include <metrics/trace.h>
+
+PipelinedGameView::PipelinedGameView(GameView* target)
+    : m_target(target)
+{
+}
+
+void PipelinedGameView::Render(const GameManager& game)
+{
+    TRACE_ZONE("PipelinedGameView::Publish");
+    SceneSnapshot& snapshot = m_snapshots.GetBack();
+    snapshot.Capture(game);
+    snapshot.frame = ++m_nbPublished;
+    snapshot.hasCamera = m_hasCamera;
+    snapshot.cameraPosition = m_cameraPosition;
+    snapshot.cameraAngle = m_cameraAngle;
+    snapshot.trackVersion = m_trackVersion;
+    snapshot.track = m_track;
+    m_snapshots.Publish();
+}
+
+void PipelinedGameView::UpdateCamera(const glm::vec2& position, float angle)
+{
+    m_hasCamera = true;
+    m_cameraPosition = position;
+    m_cameraAngle = angle;
+}
+
+void PipelinedGameView::OnReset()
+{
+    m_trackVersion++;
+    m_track.reset();
+}
+
+void PipelinedGameView::OnTrackGenerated(const Track& track)
+{
+    // Copied once per track, the snapshots share it
+    auto shape = std::make_shared<SceneSnapshot::TrackShape>();
+    shape->path = track.GetPath();
+    shape->betas = track.GetBetas();
+    shape->borders = track.GetBorders();
+    m_track = std::move(shape);
+    m_trackVersion++;
+}
+
+void PipelinedGameView::AddMemoryUsage(MemoryReport& report) const
+{
+    // The target is on its own thread, only what the simulation thread owns is counted here.
+    // The three snapshots take turns as the back buffer, they grow to the same size
+    report.Add("view/snapshots", 3 * m_snapshots.GetBack().GetMemoryUsage());
+    if (m_track != nullptr)
+    {
+        report.Add("view/track", m_track->path.capacity() * sizeof(glm::vec2) + m_track->betas.capacity() * sizeof(float) +
+            m_track->borders.capacity() / 8);
+    }
+}
+
+bool PipelinedGameView::RenderLatest()
+{
+    m_target->ProcessInput();
+    m_paused.store(m_target->IsPaused(), std::memory_order_relaxed);
+    if (m_target->RequestedClose())
+        RequestClose();
+
+    if (!m_snapshots.Acquire())
+        return false;
+
+    TRACE_ZONE("GameView::Render");
+    const int64_t start = FrameTimings::NowNs();
+    m_target->Render(m_snapshots.GetFront());
+    m_lastRenderNs.store(FrameTimings::NowNs() - start, std::memory_order_relaxed);
+    m_nbRendered++;
+    return true;
+}
@@ -0,0 +1,174 @@
+#include <racingGame/racingEnvironment.h>
+#include <racingGame/car.h>
+#include <racingGame/track.h>
+#include <utils/randomEngine.h>
+
+#include <algorithm>
+
+namespace
+{
+    GameConfig CreateHeadlessConfig()
+    {
+        GameConfig config;
+        config.enableRendering = false;
+        config.humanPlay = false;
+        config.attachCamera = false;
+        config.debugInfo = false;
+        return config;
+    }
+
+    constexpr float REWARD_TRACK_COMPLETED = 1000.0f;
+    constexpr float REWARD_PER_FRAME = -0.1f;
+    constexpr float REWARD_OUT_OF_PLAYFIELD = -100.0f;
+}
+
+RacingEnvironment::RacingEnvironment(const Config& config)
+    : m_config(config)
+    , m_generator(config.seed)
+    , m_scenario(config.nbCars, config.spawningStrategy)
+    , m_gameManager(CreateHeadlessConfig(), &m_scenario)
+    , m_observations(config.nbCars * GetObservationSize(config), 0.0f)
+    , m_rewards(config.nbCars, 0.0f)
+    , m_progress(config.nbCars, 0)
+    , m_occupancyGrid(config.grid)
+    , m_lidar(config.lidar)
+    , m_rasterizer(config.rasterizer)
+{
+    if (m_config.pixelObservations)
+        m_pixels.assign(config.nbCars * m_rasterizer.GetFrameSize(), 0);
+    m_config.frameSkip = std::max(m_config.frameSkip, 1u);
+}
+
+int RacingEnvironment::Initialize()
+{
+    RandomEngine::ScopedGenerator scopedGenerator(m_generator);
+    int errorCode = m_gameManager.Setup();
+    // Setup already generated a track
+    m_trackIsFresh = true;
+    return errorCode;
+}
+
+void RacingEnvironment::Reset()
+{
+    RandomEngine::ScopedGenerator scopedGenerator(m_generator);
+    if (!m_trackIsFresh)
+        m_gameManager.Reset();
+    m_trackIsFresh = false;
+
+    m_scenario.Update(m_gameManager);
+    for (unsigned int i = 0; i < m_config.nbCars; ++i)
+        m_progress[i] = GetProgress(i);
+
+    std::fill(m_rewards.begin(), m_rewards.end(), 0.0f);
+    m_episodeStep = 0;
+    m_done = false;
+    if (m_config.occupancyGrid)
+        m_occupancyGrid.SetTrack(*m_gameManager.GetTrack());
+    if (m_config.lidarObservations)
+        m_lidar.SetTrack(*m_gameManager.GetTrack());
+    if (m_config.pixelObservations)
+        m_rasterizer.SetTrack(*m_gameManager.GetTrack());
+    ComputeObservations();
+}
+
+void RacingEnvironment::Step(const float* actions)
+{
+    if (m_done)
+        return;
+
+    RandomEngine::ScopedGenerator scopedGenerator(m_generator);
+    for (unsigned int i = 0; i < m_config.nbCars; ++i)
+        m_scenario.GetController(i).SetAction(CarAction::FromFlat(actions + i * ACTION_SIZE));
+
+    const uint64_t nbUnspawns = m_scenario.GetNbUnspawns();
+    const float dt = GameConfigSingleton::GetInstance()->m_gameConfig.GetDt();
+    unsigned int nbFrames = 0;
+    bool outOfPlayfield = false;
+    while (nbFrames < m_config.frameSkip)
+    {
+        m_gameManager.Step(dt);
+        nbFrames++;
+        // The game manager reset the race: a car went out of the playfield
+        if (m_scenario.GetNbUnspawns() != nbUnspawns)
+        {
+            outOfPlayfield = true;
+            break;
+        }
+    }
+
+    m_episodeStep++;
+    if (outOfPlayfield)
+    {
+        // Cars are gone, keep the last observations
+        std::fill(m_rewards.begin(), m_rewards.end(), REWARD_OUT_OF_PLAYFIELD);
+        m_trackIsFresh = true;
+        m_done = true;
+        return;
+    }
+
+    const float trackLength = static_cast<float>(m_gameManager.GetTrack()->GetLength());
+    for (unsigned int i = 0; i < m_config.nbCars; ++i)
+    {
+        int progress = GetProgress(i);
+        m_rewards[i] = (progress - m_progress[i]) * REWARD_TRACK_COMPLETED / trackLength + REWARD_PER_FRAME * nbFrames;
+        m_progress[i] = progress;
+    }
+
+    m_done = m_config.maxEpisodeSteps != 0 && m_episodeStep >= m_config.maxEpisodeSteps;
+    ComputeObservations();
+}
+
+void RacingEnvironment::AddMemoryUsage(MemoryReport& report) const
+{
+    report.Add("environment", sizeof(RacingEnvironment) - sizeof(GameManager) +
+        m_state.opponentsOrdered.capacity() * sizeof(OpponentCar));
+    report.Add("observations", m_observations.capacity() * sizeof(float) + m_rewards.capacity() * sizeof(float) +
+        m_progress.capacity() * sizeof(int) + m_occupancyGrid.GetMemoryUsage() + m_lidar.GetMemoryUsage(), m_config.nbCars);
+    if (m_config.pixelObservations)
+        report.Add("pixels", m_pixels.capacity() + m_pixelCars.capacity() * sizeof(const Car*) + m_rasterizer.GetMemoryUsage(), m_config.nbCars);
+    m_gameManager.AddMemoryUsage(report);
+}
+
+int RacingEnvironment::GetProgress(unsigned int carIndex) const
+{
+    const Car* car = m_scenario.GetCar(carIndex);
+    if (car == nullptr)
+        return 0;
+    // Continuous when crossing the start line, even for cars starting with nbLaps = -1
+    return car->GetLapInfo().nbLaps * static_cast<int>(m_gameManager.GetTrack()->GetLength()) + static_cast<int>(car->GetCurrentTrackIndex());
+}
+
+void RacingEnvironment::ComputeObservations()
+{
+    const Track::Path& path = m_gameManager.GetTrack()->GetPath();
+    const size_t observationSize = GetObservationSize();
+    for (unsigned int i = 0; i < m_config.nbCars; ++i)
+    {
+        const Car* car = m_scenario.GetCar(i);
+        if (car == nullptr)
+            continue;
+        float* observation = m_observations.data() + i * observationSize;
+        CarState::GenerateState(*car, path, car->GetCurrentTrackIndex(), false, i, m_gameManager.GetCars(), m_state);
+        m_state.Flatten(observation);
+        float* extra = observation + OBSERVATION_SIZE;
+        if (m_config.occupancyGrid)
+        {
+            m_occupancyGrid.Compute(*car, m_gameManager.GetCars(), extra);
+            extra += m_occupancyGrid.GetSize();
+        }
+        if (m_config.lidarObservations)
+            m_lidar.Compute(*car, m_gameManager.GetCars(), extra);
+    }
+    RenderPixels();
+}
+
+void RacingEnvironment::RenderPixels()
+{
+    if (!m_config.pixelObservations)
+        return;
+
+    m_pixelCars.resize(m_config.nbCars);
+    for (unsigned int i = 0; i < m_config.nbCars; ++i)
+        m_pixelCars[i] = m_scenario.GetCar(i);
+    m_rasterizer.Render(m_pixelCars, m_gameManager.GetCars(), m_pixels.data());
+}
@@ -0,0 +1,45 @@
+#include <racingGame/scenarios/remotePolicyScenario.h>
+#include <racingGame/controllers/remoteCarController.h>
+#include <racingGame/car.h>
+#include <racingGame/constants.h>
+#include <racingGame/gameManager.h>
+#include <racingGame/scenarios/spawningStrategy.h>
+
+RemotePolicyScenario::RemotePolicyScenario(unsigned int nbCars, const std::string& socketPath)
+    : m_nbCars(nbCars)
+    , m_batch(socketPath)
+{
+}
+
+void RemotePolicyScenario::OnVehicleSpawned(Car* car)
+{
+    RemoteCarController* controller = new RemoteCarController(Constants::STATE_INTERVAL, m_batch);
+    m_controllers.emplace(car->GetId(), controller);
+    car->AttachController(controller);
+}
+
+void RemotePolicyScenario::OnVehicleUnspawned(Car* car)
+{
+    car->DetachController();
+    auto it = m_controllers.find(car->GetId());
+    if (it == m_controllers.end())
+        return;
+
+    delete it->second;
+    m_controllers.erase(it);
+}
+
+void RemotePolicyScenario::OnControllersUpdated()
+{
+    m_batch.Flush();
+}
+
+void RemotePolicyScenario::Update(GameManager& manager)
+{
+    if (m_controllers.size() >= m_nbCars)
+        return;
+
+    SpawningStrategy::ResetInternalVariables();
+    while (m_controllers.size() < m_nbCars)
+        SpawningStrategy::SpawnVehicle(manager, SpawningStrategy::Strategy::Strategy_Formula1);
+}
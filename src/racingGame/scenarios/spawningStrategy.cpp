@@ -41,6 +41,18 @@ void SpawningStrategy::ResetInternalVariables()
     m_currentOffset = 1.0f;
 }
 
+SpawningStrategy::ThreadState SpawningStrategy::GetThreadState()
+{
+    return { m_currentTrackIndex, m_currentOffset, m_firstCall };
+}
+
+void SpawningStrategy::SetThreadState(const ThreadState& state)
+{
+    m_currentTrackIndex = state.currentTrackIndex;
+    m_currentOffset = state.currentOffset;
+    m_firstCall = state.firstCall;
+}
+
 void SpawningStrategy::AllOnStartStrategy(::GameManager& gameManager)
 {
     gameManager.SpawnVehicle();
@@ -60,7 +72,7 @@ void SpawningStrategy::SpacedStrategy(::GameManager& gameManager)
     // - Elsewise, find the biggest index difference between 2 cars, 
     //   and spawn it in between.
 
-    std::vector<unsigned int> trackIndexes;
+    std::vector<unsigned int>& trackIndexes = m_trackIndexes;
     gameManager.GetCarsIndexOnTrack(trackIndexes);
 
     unsigned int finalIndex = 0;
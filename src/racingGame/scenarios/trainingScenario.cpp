@@ -0,0 +1,48 @@
+#include <racingGame/scenarios/trainingScenario.h>
+#include <racingGame/car.h>
+#include <racingGame/gameManager.h>
+
+#include <algorithm>
+
+TrainingScenario::TrainingScenario(unsigned int nbCars, SpawningStrategy::Strategy strategy)
+    : m_controllers(nbCars)
+    , m_cars(nbCars, nullptr)
+    , m_strategy(strategy)
+{
+}
+
+void TrainingScenario::OnVehicleSpawned(Car* car)
+{
+    auto it = std::find(m_cars.begin(), m_cars.end(), nullptr);
+    if (it == m_cars.end())
+        return;
+
+    size_t index = it - m_cars.begin();
+    *it = car;
+    m_controllers[index].SetAction(CarAction());
+    car->AttachController(&m_controllers[index]);
+    m_nbSpawnedCars++;
+}
+
+void TrainingScenario::OnVehicleUnspawned(Car* car)
+{
+    auto it = std::find(m_cars.begin(), m_cars.end(), car);
+    if (it == m_cars.end())
+        return;
+
+    car->DetachController();
+    *it = nullptr;
+    m_nbSpawnedCars--;
+    m_nbUnspawns++;
+}
+
+void TrainingScenario::Update(GameManager& manager)
+{
+    if (IsComplete())
+        return;
+
+    if (m_nbSpawnedCars == 0)
+        SpawningStrategy::ResetInternalVariables();
+    while (!IsComplete())
+        SpawningStrategy::SpawnVehicle(manager, m_strategy);
+}
@@ -0,0 +1,34 @@
+#include <racingGame/sceneSnapshot.h>
+
+#include <racingGame/car.h>
+#include <racingGame/gameManager.h>
+
+#include <Box2D/Box2D.h>
+#include <algorithm>
+
+void SceneSnapshot::Capture(const GameManager& game)
+{
+    cars.clear();
+    for (const auto& it : game.GetCars())
+    {
+        const Car& car = *it.second;
+        CarInstance instance;
+        instance.position = car.GetPosition();
+        instance.angle = car.GetAngle();
+        instance.color = car.GetHull().color;
+
+        const std::vector<Car::Wheel>& wheels = car.GetHull().wheels;
+        instance.nbWheels = static_cast<unsigned int>(std::min<size_t>(wheels.size(), 4));
+        for (unsigned int i = 0; i < instance.nbWheels; ++i)
+            instance.wheelAngles[i] = wheels[i].body->GetAngle() - instance.angle;
+        cars.push_back(instance);
+    }
+
+    const std::vector<DebugManager::DebugLine>& lines = DebugManager::GetInstance()->GetLines();
+    debugLines.assign(lines.begin(), lines.end());
+}
+
+size_t SceneSnapshot::GetMemoryUsage() const
+{
+    return cars.capacity() * sizeof(CarInstance) + debugLines.capacity() * sizeof(DebugManager::DebugLine);
+}
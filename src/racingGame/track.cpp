@@ -2,9 +2,6 @@
 
 #include <racingGame/track.h>
 #include <racingGame/constants.h>
-#include <renderable/polygon.h>
-#include <renderer/renderer.h>
-#include <shaders/shaderManager.h>
 #include <utils/randomEngine.h>
 #include <utils/utils.h>
 
@@ -13,6 +10,7 @@
 #include <algorithm>
 #include <chrono>
 #include <filesystem>
+#include <iostream>
 
 #include <glm/gtx/string_cast.hpp> 
 
@@ -171,195 +169,31 @@ bool Track::GenerateTrack()
         }
     }
 
-    // Store the path
+    // Store the path, and what the view needs to draw the road
     for (unsigned int i = 0; i < track.size(); ++i)
-        // Add to the path
-        m_path.push_back(glm::vec2(track[i][2], track[i][3]));
-
-    // If we have no rendering, stop here
-    if (!Renderer::GetInstance()->IsEnabled())
-        return true;
-
-    // Create tiles
-    std::vector<unsigned int> indexes = {
-        0, 1, 2, 
-        1, 2, 3
-    };
-    glm::vec4 roadColor(Constants::ROAD_COLOR[0], Constants::ROAD_COLOR[1], Constants::ROAD_COLOR[2], 1.0f);
-    Renderer* renderer = Renderer::GetInstance();
-    // Road data
-    std::vector<float> roadVertices;
-    std::vector<unsigned int> roadIndexes;
-    // Border data
-    std::vector<float> whiteBorderVertices;
-    std::vector<unsigned int> whiteBorderIndexes;
-    std::vector<float> redBorderVertices;
-    std::vector<unsigned int> redBorderIndexes;
-    // Generate our polygons
-    for(unsigned int i = 0; i < track.size(); ++i)
     {
-        const glm::vec4 p1 = track[i];
-        const glm::vec4 p2 = track[(i + 1) % track.size()];
-
-        roadVertices.insert(roadVertices.end(), {
-            p1[2] - Constants::TRACK_WIDTH * std::cos(p1[1]),
-            p1[3] - Constants::TRACK_WIDTH * std::sin(p1[1]),
-            Constants::LAYER_TRACK_Z,
-
-            p1[2] + Constants::TRACK_WIDTH * std::cos(p1[1]),
-            p1[3] + Constants::TRACK_WIDTH * std::sin(p1[1]),
-            Constants::LAYER_TRACK_Z,
-
-            p2[2] - Constants::TRACK_WIDTH * std::cos(p2[1]),
-            p2[3] - Constants::TRACK_WIDTH * std::sin(p2[1]),
-            Constants::LAYER_TRACK_Z,
-
-            p2[2] + Constants::TRACK_WIDTH * std::cos(p2[1]),
-            p2[3] + Constants::TRACK_WIDTH * std::sin(p2[1]),
-            Constants::LAYER_TRACK_Z
-        });
-
-        unsigned int index = 4 * i;
-        roadIndexes.insert(roadIndexes.end(), 
-            {
-                index, index + 1, index + 2,
-                index + 1, index + 2, index + 3
-            }
-        );
-
-        if (borders[i])
-        {
-            float side = std::signbit(p1[1] - p2[1]) ? -1.0f : 1.0f;
-            std::vector<float>& verticesToFill = i % 2 == 0 ? whiteBorderVertices : redBorderVertices;
-            std::vector<unsigned int>& indexesToFill = i % 2 == 0 ? whiteBorderIndexes : redBorderIndexes;
-
-            verticesToFill.insert(verticesToFill.end(),
-                {
-                p1[2] + side * Constants::TRACK_WIDTH * std::cos(p1[1]),
-                p1[3] + side * Constants::TRACK_WIDTH * std::sin(p1[1]),
-                Constants::LAYER_TRACK_Z,
-
-                p1[2] + side * (Constants::TRACK_WIDTH + Constants::BORDER) * std::cos(p1[1]),
-                p1[3] + side * (Constants::TRACK_WIDTH + Constants::BORDER) * std::sin(p1[1]),
-                Constants::LAYER_TRACK_Z,
-
-                p2[2] + side * Constants::TRACK_WIDTH * std::cos(p2[1]),
-                p2[3] + side * Constants::TRACK_WIDTH * std::sin(p2[1]),
-                Constants::LAYER_TRACK_Z,
-                
-                p2[2] + side * (Constants::TRACK_WIDTH + Constants::BORDER) * std::cos(p2[1]),
-                p2[3] + side * (Constants::TRACK_WIDTH + Constants::BORDER) * std::sin(p2[1]),
-                Constants::LAYER_TRACK_Z
-                }
-            );
-
-            index = (unsigned int)verticesToFill.size() / 3 - 4;
-            indexesToFill.insert(indexesToFill.end(),
-                {
-                    index, index + 1, index + 2,
-                    index + 1, index + 2, index + 3
-                }
-            );
-        }
+        m_path.push_back(glm::vec2(track[i][2], track[i][3]));
+        m_betas.push_back(track[i][1]);
     }
-
-    // Then create the polygons. For the track, use a specific shader
-    Shader* trackShader = ShaderManager::GetInstance()->LoadShader("track_shader.vs", "track_shader.fs");
-
-    m_tilesPolygon = new Polygon(roadVertices, roadIndexes, roadColor, trackShader);
-    renderer->AddRenderable(m_tilesPolygon);
-
-    m_bordersPolygon.push_back(new Polygon(whiteBorderVertices, whiteBorderIndexes, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)));
-    m_bordersPolygon.push_back(new Polygon(redBorderVertices, redBorderIndexes, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)));
-
-    renderer->AddRenderable(m_bordersPolygon[0]);
-    renderer->AddRenderable(m_bordersPolygon[1]);
+    m_borders = std::move(borders);
 
     m_initialAngle = track[0][1];
     return true;
 }
 
-void Track::ClearTrack()
+size_t Track::GetMemoryUsage() const
 {
-    Renderer* renderer = Renderer::GetInstance();
-
-    if (m_tilesPolygon != nullptr)
-    {
-        renderer->RemoveRenderable(m_tilesPolygon->GetId());
-        delete m_tilesPolygon;
-        m_tilesPolygon = nullptr;
-    }
-
-    for (unsigned int i = 0; i < m_bordersPolygon.size(); ++i)
-    {
-        renderer->RemoveRenderable(m_bordersPolygon[i]->GetId());
-        delete m_bordersPolygon[i];
-    }
-    m_bordersPolygon.clear();
-    m_path.clear();
-    m_initialAngle = 0.0f;
-}
-
-Track::Track()
-{
-    Renderer* renderer = Renderer::GetInstance();
-
-    // If we have no renderer, nothing to do
-    if (!renderer->IsEnabled())
-        return;
-
-    // Generate the background
-    std::vector<float> backgroundVertices = {
-        -Constants::PLAYFIELD, Constants::PLAYFIELD, Constants::LAYER_BACKGROUND_Z,
-        Constants::PLAYFIELD, Constants::PLAYFIELD, Constants::LAYER_BACKGROUND_Z,
-        Constants::PLAYFIELD, -Constants::PLAYFIELD, Constants::LAYER_BACKGROUND_Z,
-        -Constants::PLAYFIELD, -Constants::PLAYFIELD, Constants::LAYER_BACKGROUND_Z
-    };
-
-    std::vector<unsigned int> backgroundIndexes = {0, 1, 2, 0, 2, 3};
-    glm::vec4 color(Constants::BACKGROUND_COLOR1[0], Constants::BACKGROUND_COLOR1[1], Constants::BACKGROUND_COLOR1[2], 1.0f);
-    Polygon* background = new Polygon(backgroundVertices, backgroundIndexes, color);
-    renderer->AddRenderable(background);
-    m_backgroundSquares.push_back(background);
-
-    // Then add the little squares
-    int nbSquares = 20;
-    float k = Constants::PLAYFIELD / nbSquares;
-    std::vector<float> squareVertices;
-    std::vector<unsigned int> squareIndexes;
-    unsigned int currentIndex = 0;
-    for (int i = -nbSquares; i < nbSquares; i += 2)
-    {
-        for (int j = -nbSquares; j < nbSquares; j+= 2)
-        {
-                squareVertices.insert(squareVertices.end(), {
-                    k * i, k * (j + 1), Constants::LAYER_BACKGROUND_Z - 0.01f,
-                    k * (i + 1), k * (j + 1), Constants::LAYER_BACKGROUND_Z - 0.01f,
-                    k * (i + 1), k * j, Constants::LAYER_BACKGROUND_Z - 0.01f,
-                    k * i, k * j, Constants::LAYER_BACKGROUND_Z - 0.01f
-                });
-
-                squareIndexes.insert(squareIndexes.end(), 
-                {currentIndex, currentIndex + 1, currentIndex + 2,
-                 currentIndex, currentIndex + 2, currentIndex + 3});
-                currentIndex += 4;
-        }
-    }
-    glm::vec4 colorSquare(Constants::BACKGROUND_COLOR2[0], Constants::BACKGROUND_COLOR2[1], Constants::BACKGROUND_COLOR2[2], 1.0f);
-    Polygon* square = new Polygon(squareVertices, squareIndexes, colorSquare);
-    renderer->AddRenderable(square);
-    m_backgroundSquares.push_back(square);
+    // vector<bool> is a bitset
+    return sizeof(Track) + m_path.capacity() * sizeof(glm::vec2) + m_betas.capacity() * sizeof(float) +
+        (m_borders.capacity() + 7) / 8;
 }
 
-void Track::ClearBackground()
+void Track::ClearTrack()
 {
-    Renderer* renderer = Renderer::GetInstance();
-    for (Polygon* square : m_backgroundSquares)
-    {
-        renderer->RemoveRenderable(square->GetId());
-        delete square;
-    }
-    m_backgroundSquares.clear();
+    m_path.clear();
+    m_betas.clear();
+    m_borders.clear();
+    m_initialAngle = 0.0f;
 }
 
 float Track::GetAngle(size_t index, bool reverse) const
@@ -0,0 +1,240 @@
+#include <rasterizer/lidar.h>
+#include <rasterizer/rasterGeometry.h>
+
+#include <racingGame/car.h>
+#include <racingGame/track.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RACING_LIDAR_SSE2
+#endif
+
+namespace
+{
+    constexpr size_t PACKET_SIZE = 4;
+}
+
+void Lidar::Segments::Clear()
+{
+    px.clear();
+    py.clear();
+    ex.clear();
+    ey.clear();
+}
+
+void Lidar::Segments::Add(const glm::vec2& p1, const glm::vec2& p2)
+{
+    px.push_back(p1.x);
+    py.push_back(p1.y);
+    ex.push_back(p2.x - p1.x);
+    ey.push_back(p2.y - p1.y);
+}
+
+Lidar::Lidar(const Config& config)
+{
+    Configure(config);
+}
+
+void Lidar::Configure(const Config& config)
+{
+    m_config = config;
+
+    // Padding rays point forward, their result is dropped
+    const size_t nbPaddedRays = (m_config.nbRays + PACKET_SIZE - 1) / PACKET_SIZE * PACKET_SIZE;
+    m_localDirectionsX.assign(nbPaddedRays, 0.0f);
+    m_localDirectionsY.assign(nbPaddedRays, 1.0f);
+    for (unsigned int i = 0; i < m_config.nbRays; ++i)
+    {
+        // Relative to the heading, the car faces +y in its frame
+        const float angle = m_config.fov * (i + 0.5f) / m_config.nbRays - 0.5f * m_config.fov;
+        m_localDirectionsX[i] = -std::sin(angle);
+        m_localDirectionsY[i] = std::cos(angle);
+    }
+    m_directionsX.resize(nbPaddedRays);
+    m_directionsY.resize(nbPaddedRays);
+    m_distances.resize(nbPaddedRays);
+}
+
+void Lidar::SetTrack(const Track& track)
+{
+    // Left and right edges of every tile
+    m_edges.Clear();
+    glm::vec2 corners[4];
+    RasterGeometry::Bounds bounds = { glm::vec2(0.0f), glm::vec2(0.0f) };
+    for (size_t i = 0; i < track.GetLength(); ++i)
+    {
+        RasterGeometry::GetRoadQuad(track, i, corners);
+        m_edges.Add(corners[0], corners[2]);
+        m_edges.Add(corners[1], corners[3]);
+        const RasterGeometry::Bounds tileBounds = RasterGeometry::GetBounds(corners);
+        bounds.min = i == 0 ? tileBounds.min : glm::min(bounds.min, tileBounds.min);
+        bounds.max = i == 0 ? tileBounds.max : glm::max(bounds.max, tileBounds.max);
+    }
+
+    m_gridOrigin = bounds.min;
+    m_gridWidth = static_cast<int>((bounds.max.x - bounds.min.x) / m_config.cellSize) + 1;
+    m_gridHeight = static_cast<int>((bounds.max.y - bounds.min.y) / m_config.cellSize) + 1;
+
+    // Edges are short (a tile), each one is added to the cells its bounds overlap.
+    // Counted first, then filled, so each cell is a range of m_cellEdges
+    auto forEachCell = [this](size_t edge, auto&& function)
+    {
+        const glm::vec2 p1(m_edges.px[edge], m_edges.py[edge]);
+        const glm::vec2 p2 = p1 + glm::vec2(m_edges.ex[edge], m_edges.ey[edge]);
+        const glm::ivec2 cellMin = glm::ivec2((glm::min(p1, p2) - m_gridOrigin) / m_config.cellSize);
+        const glm::ivec2 cellMax = glm::ivec2((glm::max(p1, p2) - m_gridOrigin) / m_config.cellSize);
+        for (int y = cellMin.y; y <= cellMax.y; ++y)
+        {
+            for (int x = cellMin.x; x <= cellMax.x; ++x)
+                function(static_cast<size_t>(y) * m_gridWidth + x);
+        }
+    };
+
+    const size_t nbCells = static_cast<size_t>(m_gridWidth) * m_gridHeight;
+    m_cellStarts.assign(nbCells + 1, 0);
+    for (size_t edge = 0; edge < m_edges.GetSize(); ++edge)
+        forEachCell(edge, [this](size_t cell) { m_cellStarts[cell + 1]++; });
+    for (size_t cell = 0; cell < nbCells; ++cell)
+        m_cellStarts[cell + 1] += m_cellStarts[cell];
+
+    m_cellEdges.resize(m_cellStarts[nbCells]);
+    std::vector<uint32_t> fill(m_cellStarts.begin(), m_cellStarts.end() - 1);
+    for (size_t edge = 0; edge < m_edges.GetSize(); ++edge)
+        forEachCell(edge, [this, &fill, edge](size_t cell) { m_cellEdges[fill[cell]++] = static_cast<uint32_t>(edge); });
+
+    m_edgeStamps.assign(m_edges.GetSize(), 0);
+    m_stamp = 0;
+}
+
+void Lidar::Compute(const Car& egoCar, const std::unordered_map<unsigned int, Car*>& cars, float* out)
+{
+    const glm::vec2 origin = egoCar.GetPosition();
+    const float angle = egoCar.GetAngle();
+    const float c = std::cos(angle);
+    const float s = std::sin(angle);
+    for (size_t i = 0; i < m_directionsX.size(); ++i)
+    {
+        m_directionsX[i] = c * m_localDirectionsX[i] - s * m_localDirectionsY[i];
+        m_directionsY[i] = s * m_localDirectionsX[i] + c * m_localDirectionsY[i];
+    }
+
+    // Edges of the cells in range
+    m_candidates.clear();
+    if (++m_stamp == 0)
+    {
+        std::fill(m_edgeStamps.begin(), m_edgeStamps.end(), 0);
+        m_stamp = 1;
+    }
+    const glm::ivec2 cellMin = glm::max(glm::ivec2(glm::floor((origin - m_config.maxRange - m_gridOrigin) / m_config.cellSize)), glm::ivec2(0));
+    const glm::ivec2 cellMax = glm::min(glm::ivec2(glm::floor((origin + m_config.maxRange - m_gridOrigin) / m_config.cellSize)),
+        glm::ivec2(m_gridWidth - 1, m_gridHeight - 1));
+    for (int y = cellMin.y; y <= cellMax.y; ++y)
+    {
+        for (int x = cellMin.x; x <= cellMax.x; ++x)
+        {
+            const size_t cell = static_cast<size_t>(y) * m_gridWidth + x;
+            for (uint32_t i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; ++i)
+            {
+                const uint32_t edge = m_cellEdges[i];
+                if (m_edgeStamps[edge] == m_stamp)
+                    continue;
+                m_edgeStamps[edge] = m_stamp;
+                m_candidates.push_back(edge);
+            }
+        }
+    }
+
+    const unsigned int nbRays = m_config.nbRays;
+    Trace(origin, m_edges, m_candidates.data(), m_candidates.size(), m_distances.data());
+    for (unsigned int i = 0; i < nbRays; ++i)
+        out[i] = m_distances[i] / m_config.maxRange;
+
+    // Sides of the boxes of the other cars in range
+    m_carSides.Clear();
+    const float carRadius = RasterGeometry::GetCarRadius();
+    for (const auto& it : cars)
+    {
+        const Car& car = *it.second;
+        const glm::vec2 position = car.GetPosition();
+        if (&car == &egoCar || glm::length(position - origin) > m_config.maxRange + carRadius)
+            continue;
+
+        glm::vec2 corners[4];
+        RasterGeometry::GetCarQuad(car, corners);
+        m_carSides.Add(corners[0], corners[1]);
+        m_carSides.Add(corners[1], corners[3]);
+        m_carSides.Add(corners[3], corners[2]);
+        m_carSides.Add(corners[2], corners[0]);
+    }
+
+    Trace(origin, m_carSides, nullptr, m_carSides.GetSize(), m_distances.data());
+    for (unsigned int i = 0; i < nbRays; ++i)
+        out[nbRays + i] = m_distances[i] / m_config.maxRange;
+}
+
+void Lidar::Trace(const glm::vec2& origin, const Segments& segments, const uint32_t* indexes, size_t nbSegments, float* distances) const
+{
+    // Ray o + t d against segment p + s e, with w = p - o:
+    //   t = cross(w, e) / cross(d, e), s = cross(w, d) / cross(d, e)
+    // Hit when t >= 0 and s in [0, 1]. Parallel segments divide by 0: the
+    // comparisons with inf or nan are false, so they never hit.
+    const size_t nbRays = m_directionsX.size();
+    for (size_t ray = 0; ray < nbRays; ray += PACKET_SIZE)
+    {
+#ifdef RACING_LIDAR_SSE2
+        const __m128 dx = _mm_loadu_ps(m_directionsX.data() + ray);
+        const __m128 dy = _mm_loadu_ps(m_directionsY.data() + ray);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        __m128 best = _mm_set1_ps(m_config.maxRange);
+        for (size_t i = 0; i < nbSegments; ++i)
+        {
+            const size_t segment = indexes != nullptr ? indexes[i] : i;
+            const float wx = segments.px[segment] - origin.x;
+            const float wy = segments.py[segment] - origin.y;
+            const float ex = segments.ex[segment];
+            const float ey = segments.ey[segment];
+
+            const __m128 denominator = _mm_sub_ps(_mm_mul_ps(dx, _mm_set1_ps(ey)), _mm_mul_ps(dy, _mm_set1_ps(ex)));
+            const __m128 inverse = _mm_div_ps(one, denominator);
+            const __m128 t = _mm_mul_ps(_mm_set1_ps(wx * ey - wy * ex), inverse);
+            const __m128 s = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(wx), dy), _mm_mul_ps(_mm_set1_ps(wy), dx)), inverse);
+            const __m128 hit = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmplt_ps(t, best)),
+                _mm_and_ps(_mm_cmpge_ps(s, zero), _mm_cmple_ps(s, one)));
+            best = _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, best));
+        }
+        _mm_storeu_ps(distances + ray, best);
+#else
+        for (size_t lane = ray; lane < ray + PACKET_SIZE; ++lane)
+        {
+            const float dx = m_directionsX[lane];
+            const float dy = m_directionsY[lane];
+            float best = m_config.maxRange;
+            for (size_t i = 0; i < nbSegments; ++i)
+            {
+                const size_t segment = indexes != nullptr ? indexes[i] : i;
+                const float wx = segments.px[segment] - origin.x;
+                const float wy = segments.py[segment] - origin.y;
+                const float ex = segments.ex[segment];
+                const float ey = segments.ey[segment];
+                const float inverse = 1.0f / (dx * ey - dy * ex);
+                const float t = (wx * ey - wy * ex) * inverse;
+                const float s = (wx * dy - wy * dx) * inverse;
+                if (t >= 0.0f && t < best && s >= 0.0f && s <= 1.0f)
+                    best = t;
+            }
+            distances[lane] = best;
+        }
+#endif
+    }
+}
+
+size_t Lidar::GetMemoryUsage() const
+{
+    return (m_localDirectionsX.capacity() + m_localDirectionsY.capacity() + m_directionsX.capacity() + m_directionsY.capacity() +
+        m_distances.capacity()) * sizeof(float) + m_edges.GetMemoryUsage() + m_carSides.GetMemoryUsage() +
+        (m_cellStarts.capacity() + m_cellEdges.capacity() + m_edgeStamps.capacity() + m_candidates.capacity()) * sizeof(uint32_t);
+}
@@ -0,0 +1,105 @@
+#include <rasterizer/occupancyGrid.h>
+
+#include <racingGame/car.h>
+#include <racingGame/track.h>
+
+#include <algorithm>
+
+namespace
+{
+    uint8_t GetMask(OccupancyGrid::Channel channel)
+    {
+        return static_cast<uint8_t>(1u << channel);
+    }
+}
+
+OccupancyGrid::OccupancyGrid(const Config& config)
+{
+    Configure(config);
+}
+
+void OccupancyGrid::Configure(const Config& config)
+{
+    m_config = config;
+    m_cells.assign(static_cast<size_t>(m_config.size) * m_config.size, 0);
+}
+
+void OccupancyGrid::SetTrack(const Track& track)
+{
+    m_trackQuads.clear();
+    Quad quad;
+    for (size_t i = 0; i < track.GetLength(); ++i)
+    {
+        RasterGeometry::GetRoadQuad(track, i, quad.p);
+        quad.bounds = RasterGeometry::GetBounds(quad.p);
+        quad.mask = GetMask(Channel_Road);
+        m_trackQuads.push_back(quad);
+
+        if (RasterGeometry::GetBorderQuad(track, i, quad.p))
+        {
+            quad.bounds = RasterGeometry::GetBounds(quad.p);
+            quad.mask = GetMask(Channel_Border);
+            m_trackQuads.push_back(quad);
+        }
+    }
+}
+
+void OccupancyGrid::FillQuad(const RasterGeometry::EgoView& view, const glm::vec2 (&corners)[4], uint8_t mask)
+{
+    const int size = static_cast<int>(m_config.size);
+    uint8_t* cells = m_cells.data();
+    auto fillSpan = [cells, size, mask](int y, int x0, int x1)
+    {
+        uint8_t* row = cells + static_cast<size_t>(y) * size;
+        for (int x = x0; x < x1; ++x)
+            row[x] |= mask;
+    };
+
+    const glm::vec2 p0 = view.ToGrid(corners[0]);
+    const glm::vec2 p1 = view.ToGrid(corners[1]);
+    const glm::vec2 p2 = view.ToGrid(corners[2]);
+    const glm::vec2 p3 = view.ToGrid(corners[3]);
+    RasterGeometry::RasterizeTriangle(p0, p1, p2, size, size, fillSpan);
+    RasterGeometry::RasterizeTriangle(p1, p2, p3, size, size, fillSpan);
+}
+
+void OccupancyGrid::Compute(const Car& egoCar, const std::unordered_map<unsigned int, Car*>& cars, float* out)
+{
+    std::fill(m_cells.begin(), m_cells.end(), 0);
+
+    const glm::vec2 center = egoCar.GetPosition();
+    const RasterGeometry::EgoView view(center, egoCar.GetAngle(), m_config.cellSize, m_config.size, m_config.size, m_config.carPositionY);
+    const RasterGeometry::Bounds viewBounds = view.GetBounds();
+    for (const Quad& quad : m_trackQuads)
+    {
+        if (quad.bounds.Overlaps(viewBounds))
+            FillQuad(view, quad.p, quad.mask);
+    }
+
+    const float carRadius = RasterGeometry::GetCarRadius();
+    for (const auto& it : cars)
+    {
+        const Car& car = *it.second;
+        const glm::vec2 position = car.GetPosition();
+        if (&car == &egoCar || glm::length(position - center) > view.GetRadius() + carRadius)
+            continue;
+
+        glm::vec2 corners[4];
+        RasterGeometry::GetCarQuad(car, corners);
+        FillQuad(view, corners, GetMask(Channel_Cars));
+    }
+
+    const size_t nbCells = m_cells.size();
+    for (size_t channel = 0; channel < Channel_Count; ++channel)
+    {
+        const uint8_t mask = GetMask(static_cast<Channel>(channel));
+        float* channelOut = out + channel * nbCells;
+        for (size_t i = 0; i < nbCells; ++i)
+            channelOut[i] = (m_cells[i] & mask) != 0 ? 1.0f : 0.0f;
+    }
+}
+
+size_t OccupancyGrid::GetMemoryUsage() const
+{
+    return m_trackQuads.capacity() * sizeof(Quad) + m_cells.capacity();
+}
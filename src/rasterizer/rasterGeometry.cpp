@@ -0,0 +1,66 @@
+#include <rasterizer/rasterGeometry.h>
+
+#include <racingGame/car.h>
+#include <racingGame/constants.h>
+#include <racingGame/track.h>
+
+namespace
+{
+    // Footprint of the hull (see Constants::HULL_VERTICES), before SCALE_CAR
+    constexpr float HULL_HALF_WIDTH = 60.0f;
+    constexpr float HULL_FRONT = 130.0f;
+    constexpr float HULL_BACK = -120.0f;
+}
+
+namespace RasterGeometry
+{
+    void GetRoadQuad(const Track& track, size_t i, glm::vec2 (&corners)[4])
+    {
+        const Track::Path& path = track.GetPath();
+        const std::vector<float>& betas = track.GetBetas();
+        const size_t next = (i + 1) % path.size();
+        const glm::vec2 side1(std::cos(betas[i]), std::sin(betas[i]));
+        const glm::vec2 side2(std::cos(betas[next]), std::sin(betas[next]));
+        corners[0] = path[i] - Constants::TRACK_WIDTH * side1;
+        corners[1] = path[i] + Constants::TRACK_WIDTH * side1;
+        corners[2] = path[next] - Constants::TRACK_WIDTH * side2;
+        corners[3] = path[next] + Constants::TRACK_WIDTH * side2;
+    }
+
+    bool GetBorderQuad(const Track& track, size_t i, glm::vec2 (&corners)[4])
+    {
+        if (!track.GetBorders()[i])
+            return false;
+
+        const Track::Path& path = track.GetPath();
+        const std::vector<float>& betas = track.GetBetas();
+        const size_t next = (i + 1) % path.size();
+        // On the outer side of the turn
+        const float side = std::signbit(betas[i] - betas[next]) ? -1.0f : 1.0f;
+        const glm::vec2 side1 = side * glm::vec2(std::cos(betas[i]), std::sin(betas[i]));
+        const glm::vec2 side2 = side * glm::vec2(std::cos(betas[next]), std::sin(betas[next]));
+        const float outer = Constants::TRACK_WIDTH + Constants::BORDER;
+        corners[0] = path[i] + Constants::TRACK_WIDTH * side1;
+        corners[1] = path[i] + outer * side1;
+        corners[2] = path[next] + Constants::TRACK_WIDTH * side2;
+        corners[3] = path[next] + outer * side2;
+        return true;
+    }
+
+    void GetCarQuad(const Car& car, glm::vec2 (&corners)[4])
+    {
+        const glm::vec2 position = car.GetPosition();
+        const float angle = car.GetAngle();
+        const glm::vec2 right = Constants::SCALE_CAR * HULL_HALF_WIDTH * glm::vec2(std::cos(angle), std::sin(angle));
+        const glm::vec2 forward = Constants::SCALE_CAR * glm::vec2(-std::sin(angle), std::cos(angle));
+        corners[0] = position - right + HULL_FRONT * forward;
+        corners[1] = position + right + HULL_FRONT * forward;
+        corners[2] = position - right + HULL_BACK * forward;
+        corners[3] = position + right + HULL_BACK * forward;
+    }
+
+    float GetCarRadius()
+    {
+        return Constants::SCALE_CAR * std::sqrt(HULL_HALF_WIDTH * HULL_HALF_WIDTH + std::max(HULL_FRONT * HULL_FRONT, HULL_BACK * HULL_BACK));
+    }
+}
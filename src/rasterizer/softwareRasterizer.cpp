@@ -0,0 +1,239 @@
+#include <rasterizer/softwareRasterizer.h>
+#include <rasterizer/rasterGeometry.h>
+
+#include <racingGame/car.h>
+#include <racingGame/constants.h>
+#include <racingGame/track.h>
+
+#include <Box2D/Box2D.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RACING_RASTERIZER_SSE2
+#endif
+
+namespace
+{
+    // Outside of the playfield, like the clear color of the renderer
+    constexpr float CLEAR_COLOR[] = {0.2f, 0.3f, 0.3f};
+    constexpr float WHITE[] = {1.0f, 1.0f, 1.0f};
+    constexpr float RED[] = {1.0f, 0.0f, 0.0f};
+    // Shade added to the road color, cycling over the tiles (see RendererGameView::BuildTrack)
+    constexpr float ROAD_TILE_SHADE = 0.01f;
+    constexpr unsigned int NB_ROAD_SHADES = 3;
+    // Squares of the grass, like the Checkerboard of RendererGameView::CreateBackground
+    constexpr int NB_GRASS_SQUARES = 20;
+
+    constexpr size_t NB_HULL_TRIANGLES = 14;
+    constexpr size_t NB_WHEELS = 4;
+    constexpr size_t NB_CAR_TRIANGLES = NB_HULL_TRIANGLES + 2 * NB_WHEELS;
+    // Farther from its center, no part of a car
+    constexpr float CAR_RADIUS = 140.0f * Constants::SCALE_CAR;
+
+    // Packed in memory order R, G, B, A
+    uint32_t PackColor(float r, float g, float b)
+    {
+        auto toByte = [](float value) { return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+        return toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | 0xFF000000u;
+    }
+
+    uint32_t PackColor(const float (&color)[3], float shade = 0.0f)
+    {
+        return PackColor(color[0] + shade, color[1] + shade, color[2] + shade);
+    }
+
+    glm::vec2 Rotate(const glm::vec2& p, float c, float s)
+    {
+        return glm::vec2(c * p.x - s * p.y, s * p.x + c * p.y);
+    }
+
+    void FillSpan(uint32_t* row, int x0, int x1, uint32_t color)
+    {
+        int x = x0;
+#ifdef RACING_RASTERIZER_SSE2
+        const __m128i value = _mm_set1_epi32(static_cast<int>(color));
+        for (; x + 4 <= x1; x += 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), value);
+#endif
+        for (; x < x1; ++x)
+            row[x] = color;
+    }
+}
+
+SoftwareRasterizer::SoftwareRasterizer(const Config& config)
+{
+    Configure(config);
+}
+
+void SoftwareRasterizer::Configure(const Config& config)
+{
+    m_config = config;
+    m_frame.assign(static_cast<size_t>(m_config.width) * m_config.height, 0);
+}
+
+void SoftwareRasterizer::AddQuad(const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3, const glm::vec2& p4, uint32_t color)
+{
+    // Same split as the index buffers of the renderer: (1, 2, 3) and (2, 3, 4)
+    m_sceneTriangles.push_back({ { p1, p2, p3 }, color });
+    m_sceneTriangles.push_back({ { p2, p3, p4 }, color });
+    m_sceneBounds.push_back(RasterGeometry::GetBounds(p1, p2, p3));
+    m_sceneBounds.push_back(RasterGeometry::GetBounds(p2, p3, p4));
+}
+
+void SoftwareRasterizer::SetTrack(const Track& track)
+{
+    m_sceneTriangles.clear();
+    m_sceneBounds.clear();
+
+    // Grass
+    const float playfield = Constants::PLAYFIELD;
+    AddQuad({ -playfield, playfield }, { playfield, playfield }, { -playfield, -playfield }, { playfield, -playfield },
+        PackColor(Constants::BACKGROUND_COLOR1));
+    const float k = playfield / NB_GRASS_SQUARES;
+    const uint32_t squareColor = PackColor(Constants::BACKGROUND_COLOR2);
+    for (int i = -NB_GRASS_SQUARES; i < NB_GRASS_SQUARES; i += 2)
+    {
+        for (int j = -NB_GRASS_SQUARES; j < NB_GRASS_SQUARES; j += 2)
+            AddQuad({ k * i, k * (j + 1) }, { k * (i + 1), k * (j + 1) }, { k * i, k * j }, { k * (i + 1), k * j }, squareColor);
+    }
+
+    // Road tiles, then the borders on top
+    glm::vec2 corners[4];
+    for (size_t i = 0; i < track.GetLength(); ++i)
+    {
+        RasterGeometry::GetRoadQuad(track, i, corners);
+        AddQuad(corners[0], corners[1], corners[2], corners[3], PackColor(Constants::ROAD_COLOR, ROAD_TILE_SHADE * (i % NB_ROAD_SHADES)));
+    }
+    for (size_t i = 0; i < track.GetLength(); ++i)
+    {
+        if (RasterGeometry::GetBorderQuad(track, i, corners))
+            AddQuad(corners[0], corners[1], corners[2], corners[3], i % 2 == 0 ? PackColor(WHITE) : PackColor(RED));
+    }
+}
+
+void SoftwareRasterizer::PlaceCars(const std::unordered_map<unsigned int, Car*>& cars)
+{
+    m_carTriangles.clear();
+    m_carPositions.clear();
+
+    const float* hullVertices = Constants::HULL_VERTICES.begin();
+    const unsigned int* hullIndexes = Constants::HULL_INDEXES.begin();
+    const float* wheelVertices = Constants::WHEEL_VERTICES.begin();
+    const uint32_t wheelColor = PackColor(Constants::WHEEL_COLOR);
+
+    for (const auto& it : cars)
+    {
+        const Car& car = *it.second;
+        const glm::vec2 position = car.GetPosition();
+        const float angle = car.GetAngle();
+        const float c = std::cos(angle);
+        const float s = std::sin(angle);
+        auto toWorld = [&](const glm::vec2& local) { return position + Rotate(Constants::SCALE_CAR * local, c, s); };
+
+        // Wheels first, the hull is drawn over them
+        const std::vector<Car::Wheel>& wheels = car.GetHull().wheels;
+        for (size_t w = 0; w < NB_WHEELS; ++w)
+        {
+            const float wheelAngle = w < wheels.size() ? wheels[w].body->GetAngle() - angle : 0.0f;
+            const float wc = std::cos(wheelAngle);
+            const float ws = std::sin(wheelAngle);
+            const glm::vec2 center(Constants::WHEELPOS[2 * w], Constants::WHEELPOS[2 * w + 1]);
+            glm::vec2 corners[4];
+            for (size_t v = 0; v < 4; ++v)
+                corners[v] = toWorld(center + Rotate(glm::vec2(wheelVertices[3 * v], wheelVertices[3 * v + 1]), wc, ws));
+            m_carTriangles.push_back({ { corners[0], corners[1], corners[2] }, wheelColor });
+            m_carTriangles.push_back({ { corners[0], corners[2], corners[3] }, wheelColor });
+        }
+
+        const glm::vec4& color = car.GetHull().color;
+        const uint32_t hullColor = PackColor(color.r, color.g, color.b);
+        for (size_t t = 0; t < NB_HULL_TRIANGLES; ++t)
+        {
+            Triangle triangle;
+            for (size_t v = 0; v < 3; ++v)
+            {
+                const unsigned int index = hullIndexes[3 * t + v];
+                triangle.p[v] = toWorld(glm::vec2(hullVertices[3 * index], hullVertices[3 * index + 1]));
+            }
+            triangle.color = hullColor;
+            m_carTriangles.push_back(triangle);
+        }
+        m_carPositions.push_back(position);
+    }
+}
+
+void SoftwareRasterizer::Render(const std::vector<const Car*>& egoCars, const std::unordered_map<unsigned int, Car*>& cars, uint8_t* out)
+{
+    PlaceCars(cars);
+    const size_t frameSize = GetFrameSize();
+    for (size_t i = 0; i < egoCars.size(); ++i)
+    {
+        if (egoCars[i] != nullptr)
+            RenderFrame(*egoCars[i], out + i * frameSize);
+    }
+}
+
+void SoftwareRasterizer::Render(const Car& egoCar, const std::unordered_map<unsigned int, Car*>& cars, uint8_t* out)
+{
+    PlaceCars(cars);
+    RenderFrame(egoCar, out);
+}
+
+void SoftwareRasterizer::RenderFrame(const Car& egoCar, uint8_t* out)
+{
+    const int width = static_cast<int>(m_config.width);
+    const int height = static_cast<int>(m_config.height);
+    FillSpan(m_frame.data(), 0, width * height, PackColor(CLEAR_COLOR));
+
+    const glm::vec2 center = egoCar.GetPosition();
+    const RasterGeometry::EgoView view(center, egoCar.GetAngle(), m_config.metersPerPixel, m_config.width, m_config.height, m_config.carPositionY);
+    const RasterGeometry::Bounds viewBounds = view.GetBounds();
+    for (size_t i = 0; i < m_sceneTriangles.size(); ++i)
+    {
+        if (!m_sceneBounds[i].Overlaps(viewBounds))
+            continue;
+        const Triangle& triangle = m_sceneTriangles[i];
+        DrawTriangle(view.ToGrid(triangle.p[0]), view.ToGrid(triangle.p[1]), view.ToGrid(triangle.p[2]), triangle.color);
+    }
+
+    for (size_t car = 0; car < m_carPositions.size(); ++car)
+    {
+        if (glm::length(m_carPositions[car] - center) > view.GetRadius() + CAR_RADIUS)
+            continue;
+        for (size_t i = car * NB_CAR_TRIANGLES; i < (car + 1) * NB_CAR_TRIANGLES; ++i)
+        {
+            const Triangle& triangle = m_carTriangles[i];
+            DrawTriangle(view.ToGrid(triangle.p[0]), view.ToGrid(triangle.p[1]), view.ToGrid(triangle.p[2]), triangle.color);
+        }
+    }
+
+    // RGBA to RGB
+    const size_t nbPixels = m_frame.size();
+    for (size_t i = 0; i < nbPixels; ++i)
+    {
+        const uint32_t color = m_frame[i];
+        out[3 * i] = static_cast<uint8_t>(color);
+        out[3 * i + 1] = static_cast<uint8_t>(color >> 8);
+        out[3 * i + 2] = static_cast<uint8_t>(color >> 16);
+    }
+}
+
+void SoftwareRasterizer::DrawTriangle(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c, uint32_t color)
+{
+    const int width = static_cast<int>(m_config.width);
+    uint32_t* frame = m_frame.data();
+    RasterGeometry::RasterizeTriangle(a, b, c, width, static_cast<int>(m_config.height), [frame, width, color](int y, int x0, int x1)
+    {
+        FillSpan(frame + static_cast<size_t>(y) * width, x0, x1, color);
+    });
+}
+
+size_t SoftwareRasterizer::GetMemoryUsage() const
+{
+    return m_sceneTriangles.capacity() * sizeof(Triangle) + m_sceneBounds.capacity() * sizeof(RasterGeometry::Bounds) +
+        m_carTriangles.capacity() * sizeof(Triangle) + m_carPositions.capacity() * sizeof(glm::vec2) +
+        m_frame.capacity() * sizeof(uint32_t);
+}
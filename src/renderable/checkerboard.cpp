@@ -0,0 +1,49 @@
+#include <renderable/checkerboard.h>
+#include <shaders/shaderManager.h>
+
+#include <glad/glad.h>
+
+namespace
+{
+    Shader* LoadCheckerboardShader()
+    {
+        return ShaderManager::GetInstance()->LoadShader("checkerboard_shader.vs", "checkerboard_shader.fs");
+    }
+}
+
+Checkerboard::Checkerboard(float halfSize, float z, const glm::vec4& color, const glm::vec4& squareColor, float squareSize)
+    : Polygon({
+          -halfSize, halfSize, z,
+          halfSize, halfSize, z,
+          halfSize, -halfSize, z,
+          -halfSize, -halfSize, z
+      }, {0, 1, 2, 0, 2, 3}, color, LoadCheckerboardShader())
+    , m_squareColor(squareColor)
+    , m_squareSize(squareSize)
+{
+    m_squareColorLocation = m_shader->GetUniformLocation("squareColor");
+    m_squareSizeLocation = m_shader->GetUniformLocation("squareSize");
+    SetBounds(glm::vec2(-halfSize), glm::vec2(halfSize));
+}
+
+void Checkerboard::CreateShader()
+{
+    m_shader = LoadCheckerboardShader();
+}
+
+void Checkerboard::InternalDraw(const glm::mat4& mvp, RenderState& state) const
+{
+    if (m_shader == nullptr)
+        return;
+
+    state.UseShader(m_shader);
+
+    m_shader->SetMat4(m_shader->GetMvpLocation(), mvp);
+    m_shader->SetVec4(m_shader->GetColorLocation(), m_color);
+    m_shader->SetVec4(m_squareColorLocation, m_squareColor);
+    m_shader->SetFloat(m_squareSizeLocation, m_squareSize);
+
+    state.BindVertexArray(m_VAO);
+    glDrawElements(GL_TRIANGLES, m_nbVertices, GL_UNSIGNED_INT, 0);
+    state.CountDrawCall();
+}
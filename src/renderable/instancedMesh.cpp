@@ -0,0 +1,96 @@
+#include <renderable/instancedMesh.h>
+#include <renderable/mesh.h>
+#include <shaders/shaderManager.h>
+
+#include <glad/glad.h>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+
+namespace
+{
+    // See instanced_shader.vs
+    constexpr unsigned int COLOR_ATTRIBUTE = 1;
+    constexpr unsigned int TRANSFORM_ATTRIBUTE = 2;
+}
+
+InstancedMesh::InstancedMesh(const Mesh* mesh)
+    : Renderable()
+    , m_mesh(mesh)
+{
+    CreateShader();
+
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_transformVBO);
+    glGenBuffers(1, &m_colorVBO);
+
+    glBindVertexArray(m_VAO);
+    m_mesh->Attach();
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_colorVBO);
+    glVertexAttribPointer(COLOR_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void*)0);
+    glEnableVertexAttribArray(COLOR_ATTRIBUTE);
+    glVertexAttribDivisor(COLOR_ATTRIBUTE, 1);
+
+    // A mat4 attribute takes 4 locations, one per column
+    glBindBuffer(GL_ARRAY_BUFFER, m_transformVBO);
+    for (unsigned int column = 0; column < 4; ++column)
+    {
+        glVertexAttribPointer(TRANSFORM_ATTRIBUTE + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(TRANSFORM_ATTRIBUTE + column);
+        glVertexAttribDivisor(TRANSFORM_ATTRIBUTE + column, 1);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindVertexArray(0);
+}
+
+InstancedMesh::~InstancedMesh()
+{
+    glDeleteVertexArrays(1, &m_VAO);
+    glDeleteBuffers(1, &m_transformVBO);
+    glDeleteBuffers(1, &m_colorVBO);
+}
+
+void InstancedMesh::CreateShader()
+{
+    m_shader = ShaderManager::GetInstance()->LoadShader("instanced_shader.vs", "instanced_shader.fs");
+}
+
+void InstancedMesh::SetInstances(const glm::mat4* transforms, const glm::vec4* colors, unsigned int nbInstances)
+{
+    m_nbInstances = nbInstances;
+    if (nbInstances == 0)
+        return;
+
+    if (nbInstances > m_capacity)
+    {
+        m_capacity = std::max(nbInstances, 2 * m_capacity);
+        glBindBuffer(GL_ARRAY_BUFFER, m_transformVBO);
+        glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, m_colorVBO);
+        glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(glm::vec4), nullptr, GL_DYNAMIC_DRAW);
+        m_gpuBytes = m_capacity * (sizeof(glm::mat4) + sizeof(glm::vec4));
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_transformVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, nbInstances * sizeof(glm::mat4), glm::value_ptr(transforms[0]));
+    glBindBuffer(GL_ARRAY_BUFFER, m_colorVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, nbInstances * sizeof(glm::vec4), glm::value_ptr(colors[0]));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstancedMesh::InternalDraw(const glm::mat4& mvp, RenderState& state) const
+{
+    if (m_shader == nullptr || m_nbInstances == 0)
+        return;
+
+    state.UseShader(m_shader);
+
+    m_shader->SetMat4(m_shader->GetMvpLocation(), mvp);
+
+    state.BindVertexArray(m_VAO);
+    glDrawElementsInstanced(GL_TRIANGLES, m_mesh->GetNbIndexes(), GL_UNSIGNED_INT, 0, m_nbInstances);
+    state.CountDrawCall();
+}
@@ -20,6 +20,7 @@ Line::Line(const glm::vec3& p1, const glm::vec3& p2, const glm::vec4& color)
 
     glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(data), data, GL_DYNAMIC_DRAW);
+    m_gpuBytes = sizeof(data);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -48,21 +49,19 @@ void Line::UpdatePoints(const glm::vec3& p1, const glm::vec3& p2)
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
-void Line::InternalDraw(const glm::mat4& mvp) const
+void Line::InternalDraw(const glm::mat4& mvp, RenderState& state) const
 {
     if (m_shader == nullptr)
         return;
     
-    m_shader->Use();
+    state.UseShader(m_shader);
 
-    m_shader->SetMat4("MVP", mvp);
-    m_shader->SetVec4("ourColor", m_color);
+    m_shader->SetMat4(m_shader->GetMvpLocation(), mvp);
+    m_shader->SetVec4(m_shader->GetColorLocation(), m_color);
 
-    glLineWidth(0.5f);
-    glBindVertexArray(m_VAO);
+    state.SetLineWidth(0.5f);
+    state.BindVertexArray(m_VAO);
     glDrawArrays(GL_LINES,  0, 2);
-    glBindVertexArray(0);
-
-    m_shader->Disable();
+    state.CountDrawCall();
 }
 
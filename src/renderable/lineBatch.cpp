@@ -0,0 +1,75 @@
+#include <renderable/lineBatch.h>
+#include <shaders/shaderManager.h>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace
+{
+    // See line_shader.vs
+    constexpr unsigned int COLOR_ATTRIBUTE = 1;
+    constexpr unsigned int MIN_CAPACITY = 256;
+}
+
+LineBatch::LineBatch()
+    : Renderable()
+{
+    CreateShader();
+
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(COLOR_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+    glEnableVertexAttribArray(COLOR_ATTRIBUTE);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+LineBatch::~LineBatch()
+{
+    glDeleteVertexArrays(1, &m_VAO);
+    glDeleteBuffers(1, &m_VBO);
+}
+
+void LineBatch::CreateShader()
+{
+    // Same color per vertex as the instanced meshes
+    m_shader = ShaderManager::GetInstance()->LoadShader("line_shader.vs", "instanced_shader.fs");
+}
+
+void LineBatch::SetLines(const Vertex* vertices, unsigned int nbVertices)
+{
+    m_nbVertices = nbVertices;
+    if (nbVertices == 0)
+        return;
+
+    if (nbVertices > m_capacity)
+        m_capacity = std::max(std::max(nbVertices, 2 * m_capacity), MIN_CAPACITY);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    // Orphan the storage of the last frame, the driver does not wait for the draws still using it
+    glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, nbVertices * sizeof(Vertex), vertices);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_gpuBytes = m_capacity * sizeof(Vertex);
+}
+
+void LineBatch::InternalDraw(const glm::mat4& mvp, RenderState& state) const
+{
+    if (m_shader == nullptr || m_nbVertices == 0)
+        return;
+
+    state.UseShader(m_shader);
+    m_shader->SetMat4(m_shader->GetMvpLocation(), mvp);
+
+    state.SetLineWidth(0.5f);
+    state.BindVertexArray(m_VAO);
+    glDrawArrays(GL_LINES, 0, m_nbVertices);
+    state.CountDrawCall();
+}
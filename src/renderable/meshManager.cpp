@@ -0,0 +1,18 @@
+#include <renderable/meshManager.h>
+
+const Mesh* MeshManager::LoadMesh(const std::string& name, const std::vector<float>& vertices, const std::vector<unsigned int>& indexes)
+{
+    MapToMeshes::iterator it = m_mapToMeshes.find(name);
+    if (it == m_mapToMeshes.end())
+        it = m_mapToMeshes.emplace(name, std::make_unique<Mesh>(vertices, indexes)).first;
+
+    return it->second.get();
+}
+
+size_t MeshManager::GetGpuBytes() const
+{
+    size_t bytes = 0;
+    for (const auto& it : m_mapToMeshes)
+        bytes += it.second->GetGpuBytes();
+    return bytes;
+}
@@ -38,6 +38,7 @@ Polygon::Polygon(const std::vector<float>& vertices,
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes.size() * sizeof(unsigned int), indexes.data(), GL_STATIC_DRAW);
+    m_gpuBytes = vertices.size() * sizeof(float) + indexes.size() * sizeof(unsigned int);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -60,19 +61,17 @@ void Polygon::CreateShader()
     m_shader = ShaderManager::GetInstance()->LoadShader("polygon_shader.vs", "polygon_shader.fs");
 }
 
-void Polygon::InternalDraw(const glm::mat4& mvp) const
+void Polygon::InternalDraw(const glm::mat4& mvp, RenderState& state) const
 {
     if (m_shader == nullptr)
         return;
     
-    m_shader->Use();
+    state.UseShader(m_shader);
 
-    m_shader->SetMat4("MVP", mvp);
-    m_shader->SetVec4("ourColor", m_color);
+    m_shader->SetMat4(m_shader->GetMvpLocation(), mvp);
+    m_shader->SetVec4(m_shader->GetColorLocation(), m_color);
 
-    glBindVertexArray(m_VAO);
+    state.BindVertexArray(m_VAO);
     glDrawElements(GL_TRIANGLES, m_nbVertices, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-
-    m_shader->Disable();
+    state.CountDrawCall();
 }
\ No newline at end of file
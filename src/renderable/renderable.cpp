@@ -1,11 +1,14 @@
 #include <renderable/renderable.h>
 #include <glm/gtx/transform.hpp>
 #include <glm/gtx/string_cast.hpp>
+#include <cmath>
 
 void Renderable::AddChild(Renderable* child)
 {
     if (child == nullptr)
         return;
+    // Its world transform now depends on this one
+    child->m_worldDirty = true;
     m_children.emplace(child->GetId(), child);
 }
 
@@ -17,32 +20,105 @@ Renderable* Renderable::GetChild(unsigned int id)
 
 void Renderable::RemoveChild(unsigned int id)
 {
-    m_children.erase(id);
+    auto it = m_children.find(id);
+    if (it == m_children.end())
+        return;
+    // Its world transform no longer includes this one
+    it->second->m_worldDirty = true;
+    m_children.erase(it);
+}
+
+void Renderable::Submit(RenderQueue& queue, const RenderView& view) const
+{
+    Submit(queue, view, nullptr, false);
 }
 
-void Renderable::Draw(const glm::mat4& mvp) const{
+void Renderable::Submit(RenderQueue& queue, const RenderView& view, const glm::mat4* parentWorld, bool parentChanged) const
+{
     if (m_shader == nullptr)
         return;
 
-    glm::mat4 transform = GetTransform();
-    glm::mat4 new_mvp = mvp * transform;
-    InternalDraw(new_mvp);
+    // A parent that moved moves its children
+    const bool worldChanged = m_worldDirty || parentChanged;
+    if (worldChanged)
+    {
+        m_worldDirty = false;
+        m_worldTransform = parentWorld != nullptr ? *parentWorld * GetTransform() : GetTransform();
+        queue.CountTransformUpdate();
+        if (m_hasBounds)
+            TransformBounds(m_worldTransform, m_boundsMin, m_boundsMax, m_worldBoundsMin, m_worldBoundsMax);
+    }
+
+    if (m_hasBounds && view.cull && !view.Overlaps(m_worldBoundsMin, m_worldBoundsMax))
+    {
+        // The children are in the bounds, their transforms are updated when they are visible again
+        queue.CountCulled();
+        if (worldChanged)
+            MarkChildrenDirty();
+        return;
+    }
+
+    if (worldChanged || view.version != m_viewVersion)
+    {
+        m_mvp = view.viewProjection * m_worldTransform;
+        m_viewVersion = view.version;
+    }
+    if (PrepareDraw(queue, view, worldChanged))
+        queue.Add(this, m_mvp);
 
     for (auto child : m_children)
     {
-        child.second->Draw(new_mvp);
+        child.second->Submit(queue, view, &m_worldTransform, worldChanged);
     }
 }
 
-glm::mat4 Renderable::GetTransform() const
+void Renderable::TransformBounds(const glm::mat4& transform, const glm::vec2& min, const glm::vec2& max, glm::vec2& outMin, glm::vec2& outMax)
+{
+    const glm::vec2 corners[4] = { min, { max.x, min.y }, { min.x, max.y }, max };
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        const glm::vec2 corner = glm::vec2(transform * glm::vec4(corners[i], 0.0f, 1.0f));
+        outMin = i == 0 ? corner : glm::min(outMin, corner);
+        outMax = i == 0 ? corner : glm::max(outMax, corner);
+    }
+}
+
+void Renderable::MarkChildrenDirty() const
+{
+    for (auto child : m_children)
+        child.second->m_worldDirty = true;
+}
+
+const glm::mat4& Renderable::GetTransform() const
+{
+    if (!m_transformDirty)
+        return m_transform;
+    m_transformDirty = false;
+
+    if (m_rotation[0] == 0.0f && m_rotation[1] == 0.0f)
+    {
+        m_transform = ComputeTransform2D(m_position, m_rotation[2], m_scale);
+        return m_transform;
+    }
+
+    m_transform = glm::mat4(1.0f);
+    m_transform = glm::translate(m_transform, m_position);
+    m_transform = glm::rotate(m_transform, m_rotation[2], glm::vec3(0.0f, 0.0f, 1.0f));
+    m_transform = glm::rotate(m_transform, m_rotation[1], glm::vec3(0.0f, 1.0f, 0.0f));
+    m_transform = glm::rotate(m_transform, m_rotation[0], glm::vec3(1.0f, 0.0f, 0.0f));
+    m_transform = glm::scale(m_transform, m_scale);
+    return m_transform;
+}
+
+glm::mat4 Renderable::ComputeTransform2D(const glm::vec3& position, float angle, const glm::vec3& scale)
 {
-    glm::mat4 transform(1.0f);
-    transform = glm::translate(transform, m_position);
-    transform = glm::rotate(transform, m_rotation[2], glm::vec3(0.0f, 0.0f, 1.0f));
-    transform = glm::rotate(transform, m_rotation[1], glm::vec3(0.0f, 1.0f, 0.0f));
-    transform = glm::rotate(transform, m_rotation[0], glm::vec3(1.0f, 0.0f, 0.0f));
-    transform = glm::scale(transform, m_scale);
-    return transform;
+    const float c = std::cos(angle);
+    const float s = std::sin(angle);
+    return glm::mat4(
+        c * scale[0], s * scale[0], 0.0f, 0.0f,
+        -s * scale[1], c * scale[1], 0.0f, 0.0f,
+        0.0f, 0.0f, scale[2], 0.0f,
+        position[0], position[1], position[2], 1.0f);
 }
 
 void Renderable::SetRoationFromMatrix(const glm::mat4& mat)
@@ -67,4 +143,5 @@ void Renderable::SetRoationFromMatrix(const glm::mat4& mat)
         z = 0;
     }
     m_rotation = glm::vec3(x, y, z);
+    MarkTransformDirty();
 }
@@ -0,0 +1,122 @@
+#include <renderable/trackMesh.h>
+#include <shaders/shaderManager.h>
+
+#include <glad/glad.h>
+
+#include <cstddef>
+
+namespace
+{
+    // See track_shader.vs
+    constexpr unsigned int COLOR_ATTRIBUTE = 1;
+}
+
+TrackMesh::TrackMesh()
+    : Renderable()
+{
+    CreateShader();
+
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+    glGenBuffers(1, &m_EBO);
+
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(COLOR_ATTRIBUTE, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+    glEnableVertexAttribArray(COLOR_ATTRIBUTE);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBindVertexArray(0);
+}
+
+TrackMesh::~TrackMesh()
+{
+    glDeleteVertexArrays(1, &m_VAO);
+    glDeleteBuffers(1, &m_VBO);
+    glDeleteBuffers(1, &m_EBO);
+}
+
+void TrackMesh::CreateShader()
+{
+    m_shader = ShaderManager::GetInstance()->LoadShader("track_shader.vs", "track_shader.fs");
+}
+
+void TrackMesh::SetGeometry(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indexes, const std::vector<Chunk>& chunks)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // The element buffer binding is part of the vertex array state, bind it without one
+    glBindVertexArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes.size() * sizeof(unsigned int), indexes.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    m_gpuBytes = vertices.size() * sizeof(Vertex) + indexes.size() * sizeof(unsigned int);
+
+    m_chunks = chunks;
+    m_worldChunkBounds.resize(2 * m_chunks.size());
+    m_chunkBoundsDirty = true;
+    m_drawCounts.reserve(m_chunks.size());
+    m_drawOffsets.reserve(m_chunks.size());
+
+    // The track bounds, for the whole mesh to be culled at once
+    glm::vec2 min(0.0f);
+    glm::vec2 max(0.0f);
+    for (size_t i = 0; i < m_chunks.size(); ++i)
+    {
+        min = i == 0 ? m_chunks[i].min : glm::min(min, m_chunks[i].min);
+        max = i == 0 ? m_chunks[i].max : glm::max(max, m_chunks[i].max);
+    }
+    SetBounds(min, max);
+}
+
+bool TrackMesh::PrepareDraw(RenderQueue& queue, const RenderView& view, bool) const
+{
+    // The world transform may have changed while the whole mesh was culled, compare with the one used
+    if (m_chunkBoundsDirty || m_chunkBoundsTransform != m_worldTransform)
+    {
+        m_chunkBoundsDirty = false;
+        m_chunkBoundsTransform = m_worldTransform;
+        for (size_t i = 0; i < m_chunks.size(); ++i)
+            TransformBounds(m_worldTransform, m_chunks[i].min, m_chunks[i].max, m_worldChunkBounds[2 * i], m_worldChunkBounds[2 * i + 1]);
+    }
+
+    m_drawCounts.clear();
+    m_drawOffsets.clear();
+    unsigned int rangeEnd = 0;
+    for (size_t i = 0; i < m_chunks.size(); ++i)
+    {
+        const Chunk& chunk = m_chunks[i];
+        if (view.cull && !view.Overlaps(m_worldChunkBounds[2 * i], m_worldChunkBounds[2 * i + 1]))
+        {
+            queue.CountCulled();
+            continue;
+        }
+
+        if (!m_drawCounts.empty() && chunk.firstIndex == rangeEnd)
+            m_drawCounts.back() += static_cast<int>(chunk.nbIndexes);
+        else
+        {
+            m_drawCounts.push_back(static_cast<int>(chunk.nbIndexes));
+            m_drawOffsets.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(chunk.firstIndex) * sizeof(unsigned int)));
+        }
+        rangeEnd = chunk.firstIndex + chunk.nbIndexes;
+    }
+    return !m_drawCounts.empty();
+}
+
+void TrackMesh::InternalDraw(const glm::mat4& mvp, RenderState& state) const
+{
+    if (m_shader == nullptr || m_drawCounts.empty())
+        return;
+
+    state.UseShader(m_shader);
+    m_shader->SetMat4(m_shader->GetMvpLocation(), mvp);
+
+    state.BindVertexArray(m_VAO);
+    glMultiDrawElements(GL_TRIANGLES, m_drawCounts.data(), GL_UNSIGNED_INT, m_drawOffsets.data(), static_cast<GLsizei>(m_drawCounts.size()));
+    state.CountDrawCall();
+}
@@ -26,6 +26,7 @@ Triangle::Triangle(const std::vector<float>& data)
  
     glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
     glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(), GL_STATIC_DRAW);
+    m_gpuBytes = data.size() * sizeof(float);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0); 
@@ -51,16 +52,16 @@ void Triangle::CreateShader()
     //     "C:\\Users\\adrie\\Documents\\Programming\\Renderer\\shaders\\shader.fs");
 }
 
-void Triangle::InternalDraw(const glm::mat4& mvp) const
+void Triangle::InternalDraw(const glm::mat4& mvp, RenderState& state) const
 {
     if (m_shader == nullptr)
         return;
 
-    m_shader->Use();
+    state.UseShader(m_shader);
 
-    m_shader->SetMat4("MVP", mvp);
+    m_shader->SetMat4(m_shader->GetMvpLocation(), mvp);
 
-    glBindVertexArray(m_VAO);
+    state.BindVertexArray(m_VAO);
     glDrawArrays(GL_TRIANGLES, 0, 3);
-    glBindVertexArray(0);
+    state.CountDrawCall();
 }
\ No newline at end of file
@@ -39,4 +39,24 @@ void Camera::Zoom(float factor)
     m_orthgraphicParams.bottom += factor;
     m_orthgraphicParams.left += factor;
     m_orthgraphicParams.right -= factor;
+}
+
+bool Camera::GetOrthographicBounds(glm::vec2& min, glm::vec2& max) const
+{
+    if (m_isPerspective)
+        return false;
+
+    const glm::mat4 viewToWorld = glm::inverse(GetViewMatrix());
+    const OrthographicParams& params = m_orthgraphicParams;
+    const glm::vec2 corners[4] = {
+        { params.left, params.bottom }, { params.right, params.bottom },
+        { params.left, params.top }, { params.right, params.top }
+    };
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        const glm::vec2 corner = glm::vec2(viewToWorld * glm::vec4(corners[i], 0.0f, 1.0f));
+        min = i == 0 ? corner : glm::min(min, corner);
+        max = i == 0 ? corner : glm::max(max, corner);
+    }
+    return true;
 }
\ No newline at end of file
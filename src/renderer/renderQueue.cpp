@@ -0,0 +1,102 @@
+#include <renderer/renderQueue.h>
+
+#include <metrics/trace.h>
+#include <renderable/renderable.h>
+#include <shaders/shaders.h>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+
+namespace
+{
+    // Zone of each drawn item, by RenderLayer
+    const char* const DRAW_ZONE_NAMES[] = {
+        "Renderable::Draw (background)",
+        "Renderable::Draw (track)",
+        "Renderable::Draw (cars)",
+        "Renderable::Draw (debug)"
+    };
+}
+
+void RenderState::UseShader(const Shader* shader)
+{
+    const unsigned int program = shader != nullptr ? shader->m_ID : 0;
+    if (program == m_program)
+    {
+        m_stats.nbSkippedChanges++;
+        return;
+    }
+    glUseProgram(program);
+    m_program = program;
+    m_stats.nbProgramChanges++;
+}
+
+void RenderState::BindVertexArray(unsigned int vertexArray)
+{
+    if (vertexArray == m_vertexArray)
+    {
+        m_stats.nbSkippedChanges++;
+        return;
+    }
+    glBindVertexArray(vertexArray);
+    m_vertexArray = vertexArray;
+    m_stats.nbVertexArrayChanges++;
+}
+
+void RenderState::SetLineWidth(float width)
+{
+    if (width == m_lineWidth)
+        return;
+    glLineWidth(width);
+    m_lineWidth = width;
+}
+
+void RenderState::Reset()
+{
+    if (m_vertexArray != 0)
+        glBindVertexArray(0);
+    if (m_program != 0)
+        glUseProgram(0);
+    m_vertexArray = 0;
+    m_program = 0;
+}
+
+void RenderQueue::Clear()
+{
+    m_items.clear();
+    m_order.clear();
+    m_nbTransformUpdates = 0;
+    m_nbCulled = 0;
+}
+
+void RenderQueue::Add(const Renderable* renderable, const glm::mat4& mvp)
+{
+    const Shader* shader = renderable->GetShader();
+    const uint64_t program = shader != nullptr ? shader->m_ID : 0;
+    const uint64_t key = (static_cast<uint64_t>(renderable->GetLayer()) << 56) | ((program & 0xFFFFFF) << 32) |
+        renderable->GetVertexArray();
+    m_order.push_back({ key, static_cast<uint32_t>(m_items.size()) });
+    m_items.push_back({ renderable, mvp });
+}
+
+void RenderQueue::Sort()
+{
+    std::sort(m_order.begin(), m_order.end(), [](const SortKey& a, const SortKey& b)
+    {
+        return a.key < b.key || (a.key == b.key && a.index < b.index);
+    });
+}
+
+void RenderQueue::Draw(RenderState& state) const
+{
+    state.GetStats().nbItems += static_cast<unsigned int>(m_order.size());
+    state.GetStats().nbTransformUpdates += m_nbTransformUpdates;
+    state.GetStats().nbCulled += m_nbCulled;
+    for (const SortKey& sortKey : m_order)
+    {
+        const Item& item = m_items[sortKey.index];
+        TRACE_ZONE(DRAW_ZONE_NAMES[item.renderable->GetLayer()]);
+        item.renderable->InternalDraw(item.mvp, state);
+    }
+}
@@ -7,6 +7,7 @@
 
 #include <shaders/shaders.h>
 #include <renderable/renderable.h>
+#include <metrics/trace.h>
 
 namespace {
     void framebuffer_size_callback(GLFWwindow*, int width, int height)
@@ -53,6 +54,25 @@ int Renderer::Initialize(unsigned int width, unsigned int height)
     return 0;
 }
 
+int Renderer::InitializeWithContext(unsigned int width, unsigned int height, LoadProc loadProc)
+{
+    if (!m_enable || m_initialize)
+        return 0;
+
+    if (!gladLoadGLLoader(loadProc))
+    {
+        std::cout << "Failed to initialize GLAD" << std::endl;
+        return -1;
+    }
+
+    glViewport(0, 0, width, height);
+    glEnable(GL_DEPTH_TEST);
+
+    m_initialize = true;
+
+    return 0;
+}
+
 void Renderer::Close()
 {
     if (m_window != nullptr)
@@ -60,6 +80,7 @@ void Renderer::Close()
         glfwTerminate();
         m_window = nullptr;
     }
+    m_initialize = false;
 }
 
 Renderer::~Renderer()
@@ -69,22 +90,46 @@ Renderer::~Renderer()
 
 void Renderer::Render()
 {
-    if (m_window == nullptr || !m_enable)
+    if (!m_initialize || !m_enable)
         return;
 
+    TRACE_ZONE("Renderer::Render");
     glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // Compute PV matrix
     glm::mat4 PV = m_camera.GetProjectionMatrix() * m_camera.GetViewMatrix();
-    
-    for (auto pair : m_mapToRenderable)
+    if (PV != m_view.viewProjection || m_view.version == 0)
+    {
+        m_view.viewProjection = PV;
+        m_view.version++;
+    }
+    m_view.cull = m_cullQueue && m_camera.GetOrthographicBounds(m_view.min, m_view.max);
+
+    m_queue.Clear();
+    for (const auto& pair : m_mapToRenderable)
     {
-        pair.second->Draw(PV);
+        pair.second->Submit(m_queue, m_view);
     }
 
-    glfwSwapBuffers(m_window);
-    glfwPollEvents();
+    if (m_sortQueue)
+    {
+        TRACE_ZONE("RenderQueue::Sort");
+        m_queue.Sort();
+    }
+
+    {
+        TRACE_ZONE("RenderQueue::Draw");
+        m_state.GetStats().Clear();
+        m_queue.Draw(m_state);
+        m_state.Reset();
+    }
+
+    if (m_window != nullptr)
+    {
+        glfwSwapBuffers(m_window);
+        glfwPollEvents();
+    }
 }
 
 void Renderer::ProcessInput()
@@ -97,7 +142,7 @@ void Renderer::ProcessInput()
 
     constexpr float factor = 2.0f;
 
-    for (auto it : m_inputCallbacks)
+    for (const auto& it : m_inputCallbacks)
         it.second.second(glfwGetKey(m_window, it.second.first));
 
     if(glfwGetKey(m_window, GLFW_KEY_A) == GLFW_PRESS)
@@ -0,0 +1,411 @@
+#include <renderer/rendererGameView.h>
+
+#include <racingGame/car.h>
+#include <racingGame/constants.h>
+#include <racingGame/gameConfig.h>
+#include <racingGame/gameManager.h>
+#include <racingGame/track.h>
+#include <debugManager/debugManager.h>
+#include <metrics/memoryReport.h>
+#include <metrics/trace.h>
+#include <renderable/checkerboard.h>
+#include <renderable/instancedMesh.h>
+#include <renderable/lineBatch.h>
+#include <renderable/meshManager.h>
+#include <renderable/trackMesh.h>
+#include <renderer/renderer.h>
+#include <shaders/shaderManager.h>
+
+#include <Box2D/Box2D.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Tiles of track per chunk, culled together
+    constexpr unsigned int TRACK_CHUNK_TILES = 15;
+    // Shade added to the road color, cycling over the tiles
+    constexpr float ROAD_TILE_SHADE = 0.01f;
+    constexpr unsigned int NB_ROAD_SHADES = 3;
+    // Squares of the grass per half side
+    constexpr int NB_GRASS_SQUARES = 20;
+    // Farther from its center, no part of a car
+    constexpr float CAR_RADIUS = 140.0f * Constants::SCALE_CAR;
+
+    uint8_t ToColorByte(float value)
+    {
+        return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+RendererGameView::~RendererGameView()
+{
+    Close();
+    if (m_holdsSingletons)
+    {
+        MeshManager::DestroyInstance();
+        ShaderManager::DestroyInstance();
+        Renderer::DestroyInstance();
+        m_holdsSingletons = false;
+    }
+}
+
+int RendererGameView::Initialize(const GameConfig& config)
+{
+    if (!m_holdsSingletons)
+    {
+        Renderer::CreateInstance();
+        ShaderManager::CreateInstance();
+        MeshManager::CreateInstance();
+        m_holdsSingletons = true;
+    }
+
+    Renderer* renderer = Renderer::GetInstance();
+    renderer->Enable(config.enableRendering);
+    int errorCode = renderer->Initialize(config.windowWidth, config.windowHeight);
+    if (errorCode != 0)
+        return errorCode;
+
+    m_enabled = config.enableRendering;
+    if (!m_enabled)
+        return 0;
+
+    // Setup the camera
+    Camera& camera = renderer->GetCamera();
+    camera.SetIsOrthographic();
+    camera.SetPosition(glm::vec3(0.0f, 0.0f, -1.0f));
+    camera.SetDirection(glm::vec3(0.0f, 0.0f, 1.0f));
+    camera.SetUp(glm::vec3(0.0f, 1.0f, 0.0f));
+    Camera::OrthographicParams& params = camera.GetOrthographicParams();
+    // Setup differently if we are attached or not to a car
+    if (config.attachCamera)
+        params = { -30.0f, 30.0f, -30.0f, 30.0f, -0.1f, 10.0f };
+    else
+        params = { -200.0f, 200.0f, -200.0f, 200.0f, -0.1f, 10.0f };
+
+    if (m_background == nullptr)
+        CreateBackground();
+    if (m_track == nullptr)
+        CreateTrackMesh();
+    if (m_debugLines == nullptr)
+    {
+        m_debugLines = new LineBatch();
+        m_debugLines->SetLayer(RenderLayer_Debug);
+        renderer->AddRenderable(m_debugLines);
+    }
+    if (m_hulls == nullptr)
+        CreateCarMeshes();
+    return 0;
+}
+
+void RendererGameView::Close()
+{
+    if (!m_enabled)
+        return;
+
+    // Release the GL objects while the context is still alive
+    DestroyCarMeshes();
+
+    DestroyRenderable(m_debugLines);
+    DestroyRenderable(m_track);
+    DestroyRenderable(m_background);
+    MeshManager::GetInstance()->Clear();
+
+    Renderer::GetInstance()->Close();
+    m_enabled = false;
+}
+
+bool RendererGameView::IsPaused() const
+{
+    return m_enabled && Renderer::GetInstance()->paused;
+}
+
+bool RendererGameView::RequestedClose()
+{
+    return Renderer::GetInstance()->RequestedClose();
+}
+
+void RendererGameView::ProcessInput()
+{
+    Renderer::GetInstance()->ProcessInput();
+}
+
+void RendererGameView::Render(const GameManager& game)
+{
+    if (!m_enabled)
+        return;
+
+    // Same path as the pipelined mode, the track and the camera are already up to date
+    m_frame.Capture(game);
+    Draw(m_frame);
+}
+
+void RendererGameView::Render(const SceneSnapshot& snapshot)
+{
+    if (!m_enabled)
+        return;
+
+    if (snapshot.trackVersion != m_trackVersion)
+    {
+        m_trackVersion = snapshot.trackVersion;
+        if (snapshot.track != nullptr)
+            BuildTrack(snapshot.track->path, snapshot.track->betas, snapshot.track->borders);
+        else
+            ClearTrack();
+    }
+    if (snapshot.hasCamera)
+        UpdateCamera(snapshot.cameraPosition, snapshot.cameraAngle);
+    Draw(snapshot);
+}
+
+void RendererGameView::Draw(const SceneSnapshot& snapshot)
+{
+    {
+        TRACE_ZONE("RendererGameView::UpdateCars");
+        UpdateCars(snapshot.cars);
+    }
+    {
+        TRACE_ZONE("RendererGameView::UpdateDebugLines");
+        UpdateDebugLines(snapshot.debugLines);
+    }
+    Renderer::GetInstance()->Render();
+}
+
+void RendererGameView::UpdateCamera(const glm::vec2& position, float angle)
+{
+    if (!m_enabled)
+        return;
+
+    Camera& camera = Renderer::GetInstance()->GetCamera();
+
+    // Set the rotation with the up vector
+    glm::vec3 up(glm::vec3(-std::sin(angle), std::cos(angle), 0.0f));
+    camera.SetUp(up);
+
+    // Snap the camera to the car, minus an offset, to see more of the road
+    glm::vec3 cameraNewPos(position[0], position[1], camera.GetPosition()[2]);
+    cameraNewPos += up * 10.0f;
+    camera.SetPosition(cameraNewPos);
+}
+
+void RendererGameView::OnReset()
+{
+    if (!m_enabled)
+        return;
+
+    Renderer::GetInstance()->ClearInputCallbacks();
+    ClearTrack();
+}
+
+void RendererGameView::ClearTrack()
+{
+    m_trackVertices.clear();
+    m_trackIndexes.clear();
+    m_trackChunks.clear();
+    m_track->SetGeometry(m_trackVertices, m_trackIndexes, m_trackChunks);
+}
+
+void RendererGameView::OnTrackGenerated(const Track& track)
+{
+    if (!m_enabled)
+        return;
+
+    BuildTrack(track.GetPath(), track.GetBetas(), track.GetBorders());
+}
+
+void RendererGameView::BuildTrack(const Track::Path& path, const std::vector<float>& betas, const std::vector<bool>& borders)
+{
+    const uint8_t white[4] = { 255, 255, 255, 255 };
+    const uint8_t red[4] = { 255, 0, 0, 255 };
+    uint8_t roadColors[NB_ROAD_SHADES][4];
+    for (unsigned int shade = 0; shade < NB_ROAD_SHADES; ++shade)
+    {
+        for (unsigned int c = 0; c < 3; ++c)
+            roadColors[shade][c] = ToColorByte(Constants::ROAD_COLOR[c] + ROAD_TILE_SHADE * shade);
+        roadColors[shade][3] = 255;
+    }
+
+    auto addQuad = [this](const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3, const glm::vec2& p4, const uint8_t (&color)[4])
+    {
+        const unsigned int index = (unsigned int)m_trackVertices.size();
+        for (const glm::vec2* p : { &p1, &p2, &p3, &p4 })
+            m_trackVertices.push_back({ glm::vec3(*p, Constants::LAYER_TRACK_Z), { color[0], color[1], color[2], color[3] } });
+        m_trackIndexes.insert(m_trackIndexes.end(),
+            {
+                index, index + 1, index + 2,
+                index + 1, index + 2, index + 3
+            }
+        );
+    };
+
+    m_trackVertices.clear();
+    m_trackIndexes.clear();
+    m_trackChunks.clear();
+    // All in one buffer, chunk by chunk: the road of the tiles, then their borders
+    for (unsigned int chunkStart = 0; chunkStart < path.size(); chunkStart += TRACK_CHUNK_TILES)
+    {
+        const unsigned int chunkEnd = std::min(chunkStart + TRACK_CHUNK_TILES, (unsigned int)path.size());
+        const unsigned int firstIndex = (unsigned int)m_trackIndexes.size();
+        const unsigned int firstVertex = (unsigned int)m_trackVertices.size();
+        for (unsigned int i = chunkStart; i < chunkEnd; ++i)
+        {
+            unsigned int next = (i + 1) % path.size();
+            const glm::vec2 left1(-std::cos(betas[i]), -std::sin(betas[i]));
+            const glm::vec2 left2(-std::cos(betas[next]), -std::sin(betas[next]));
+            addQuad(path[i] + Constants::TRACK_WIDTH * left1, path[i] - Constants::TRACK_WIDTH * left1,
+                    path[next] + Constants::TRACK_WIDTH * left2, path[next] - Constants::TRACK_WIDTH * left2,
+                    roadColors[i % NB_ROAD_SHADES]);
+        }
+        for (unsigned int i = chunkStart; i < chunkEnd; ++i)
+        {
+            if (!borders[i])
+                continue;
+
+            unsigned int next = (i + 1) % path.size();
+            const float beta1 = betas[i];
+            const float beta2 = betas[next];
+            float side = std::signbit(beta1 - beta2) ? -1.0f : 1.0f;
+            const glm::vec2 out1(side * std::cos(beta1), side * std::sin(beta1));
+            const glm::vec2 out2(side * std::cos(beta2), side * std::sin(beta2));
+            addQuad(path[i] + Constants::TRACK_WIDTH * out1, path[i] + (Constants::TRACK_WIDTH + Constants::BORDER) * out1,
+                    path[next] + Constants::TRACK_WIDTH * out2, path[next] + (Constants::TRACK_WIDTH + Constants::BORDER) * out2,
+                    i % 2 == 0 ? white : red);
+        }
+
+        TrackMesh::Chunk chunk{ firstIndex, (unsigned int)m_trackIndexes.size() - firstIndex, glm::vec2(0.0f), glm::vec2(0.0f) };
+        for (unsigned int v = firstVertex; v < m_trackVertices.size(); ++v)
+        {
+            const glm::vec2 position(m_trackVertices[v].position);
+            chunk.min = v == firstVertex ? position : glm::min(chunk.min, position);
+            chunk.max = v == firstVertex ? position : glm::max(chunk.max, position);
+        }
+        m_trackChunks.push_back(chunk);
+    }
+
+    m_track->SetGeometry(m_trackVertices, m_trackIndexes, m_trackChunks);
+}
+
+void RendererGameView::AddMemoryUsage(MemoryReport& report) const
+{
+    if (m_background != nullptr)
+        report.Add("gl/background", m_background->GetGpuBytes());
+    if (m_track != nullptr)
+    {
+        report.Add("gl/track", m_track->GetGpuBytes() + m_trackVertices.capacity() * sizeof(TrackMesh::Vertex) +
+            m_trackIndexes.capacity() * sizeof(unsigned int) + m_trackChunks.capacity() * sizeof(TrackMesh::Chunk));
+    }
+    if (m_hulls != nullptr)
+    {
+        report.Add("gl/cars", m_hulls->GetGpuBytes() + m_wheels->GetGpuBytes() +
+            (m_hullTransforms.capacity() + m_wheelTransforms.capacity()) * sizeof(glm::mat4) +
+            (m_hullColors.capacity() + m_wheelColors.capacity()) * sizeof(glm::vec4));
+    }
+    report.Add("view/frame", m_frame.GetMemoryUsage());
+    report.Add("gl/meshes", MeshManager::GetInstance()->GetGpuBytes());
+    if (m_debugLines != nullptr)
+        report.Add("gl/debugLines", m_debugLines->GetGpuBytes() + m_debugVertices.capacity() * sizeof(LineBatch::Vertex));
+}
+
+void RendererGameView::CreateBackground()
+{
+    const glm::vec4 color(Constants::BACKGROUND_COLOR1[0], Constants::BACKGROUND_COLOR1[1], Constants::BACKGROUND_COLOR1[2], 1.0f);
+    const glm::vec4 colorSquare(Constants::BACKGROUND_COLOR2[0], Constants::BACKGROUND_COLOR2[1], Constants::BACKGROUND_COLOR2[2], 1.0f);
+    m_background = new Checkerboard(Constants::PLAYFIELD, Constants::LAYER_BACKGROUND_Z, color, colorSquare, Constants::PLAYFIELD / NB_GRASS_SQUARES);
+    m_background->SetLayer(RenderLayer_Background);
+    Renderer::GetInstance()->AddRenderable(m_background);
+}
+
+void RendererGameView::CreateTrackMesh()
+{
+    m_track = new TrackMesh();
+    m_track->SetLayer(RenderLayer_Track);
+    Renderer::GetInstance()->AddRenderable(m_track);
+}
+
+void RendererGameView::CreateCarMeshes()
+{
+    MeshManager* meshManager = MeshManager::GetInstance();
+    const Mesh* hullMesh = meshManager->LoadMesh("hull", Constants::HULL_VERTICES, Constants::HULL_INDEXES);
+    const Mesh* wheelMesh = meshManager->LoadMesh("wheel", Constants::WHEEL_VERTICES, {0, 1, 2, 0, 2, 3});
+
+    m_hulls = new InstancedMesh(hullMesh);
+    m_hulls->SetLayer(RenderLayer_Cars);
+    Renderer::GetInstance()->AddRenderable(m_hulls);
+    m_wheels = new InstancedMesh(wheelMesh);
+    m_wheels->SetLayer(RenderLayer_Cars);
+    Renderer::GetInstance()->AddRenderable(m_wheels);
+}
+
+void RendererGameView::DestroyCarMeshes()
+{
+    if (m_hulls == nullptr)
+        return;
+
+    Renderer* renderer = Renderer::GetInstance();
+    renderer->RemoveRenderable(m_hulls->GetId());
+    renderer->RemoveRenderable(m_wheels->GetId());
+    delete m_hulls;
+    delete m_wheels;
+    m_hulls = nullptr;
+    m_wheels = nullptr;
+}
+
+void RendererGameView::UpdateCars(const std::vector<SceneSnapshot::CarInstance>& cars)
+{
+    m_hullTransforms.clear();
+    m_hullColors.clear();
+    m_wheelTransforms.clear();
+    m_wheelColors.clear();
+
+    // Cars out of the camera are not uploaded
+    const Renderer* renderer = Renderer::GetInstance();
+    glm::vec2 viewMin(0.0f);
+    glm::vec2 viewMax(0.0f);
+    const bool cull = renderer->IsCullingEnabled() && renderer->GetCamera().GetOrthographicBounds(viewMin, viewMax);
+    viewMin -= glm::vec2(CAR_RADIUS);
+    viewMax += glm::vec2(CAR_RADIUS);
+
+    const glm::vec4 wheelColor(Constants::WHEEL_COLOR[0], Constants::WHEEL_COLOR[1], Constants::WHEEL_COLOR[2], 1.0f);
+    const glm::vec3 carScale(Constants::SCALE_CAR, Constants::SCALE_CAR, 1.0f);
+    for (const SceneSnapshot::CarInstance& car : cars)
+    {
+        if (cull && (glm::any(glm::lessThan(car.position, viewMin)) || glm::any(glm::greaterThan(car.position, viewMax))))
+            continue;
+        const glm::mat4 hullTransform = Renderable::ComputeTransform2D(glm::vec3(car.position, 0.0f), car.angle, carScale);
+        m_hullTransforms.push_back(hullTransform);
+        m_hullColors.push_back(car.color);
+
+        // Wheels are placed in the frame of the hull
+        for (unsigned int i = 0; i < car.nbWheels; ++i)
+        {
+            const glm::vec3 wheelPosition(Constants::WHEELPOS[2 * i], Constants::WHEELPOS[2 * i + 1], 0.0f);
+            m_wheelTransforms.push_back(hullTransform * Renderable::ComputeTransform2D(wheelPosition, car.wheelAngles[i], glm::vec3(1.0f)));
+            m_wheelColors.push_back(wheelColor);
+        }
+    }
+
+    m_hulls->SetInstances(m_hullTransforms.data(), m_hullColors.data(), static_cast<unsigned int>(m_hullTransforms.size()));
+    m_wheels->SetInstances(m_wheelTransforms.data(), m_wheelColors.data(), static_cast<unsigned int>(m_wheelTransforms.size()));
+}
+
+void RendererGameView::UpdateDebugLines(const std::vector<DebugManager::DebugLine>& lines)
+{
+    m_debugVertices.clear();
+    for (const DebugManager::DebugLine& line : lines)
+    {
+        m_debugVertices.push_back({ line.p1, line.color });
+        m_debugVertices.push_back({ line.p2, line.color });
+    }
+    m_debugLines->SetLines(m_debugVertices.data(), static_cast<unsigned int>(m_debugVertices.size()));
+}
+
+template <typename T>
+void RendererGameView::DestroyRenderable(T*& renderable)
+{
+    if (renderable == nullptr)
+        return;
+
+    Renderer::GetInstance()->RemoveRenderable(renderable->GetId());
+    delete renderable;
+    renderable = nullptr;
+}
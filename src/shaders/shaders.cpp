@@ -87,6 +87,7 @@ Shader::Shader(const char* vertexShaderName, const char* fragmentShaderName)
     // delete the shaders as they're linked into our program now and no longer necessary
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+    CacheUniformLocations();
 }
 // activate the shader
 // ------------------------------------------------------------------------
@@ -103,27 +104,66 @@ void Shader::Disable() const
 // ------------------------------------------------------------------------
 void Shader::SetBool(const std::string &name, bool value) const
 {         
-    glUniform1i(glGetUniformLocation(m_ID, name.c_str()), (int)value); 
+    glUniform1i(GetUniformLocation(name), (int)value); 
 }
 // ------------------------------------------------------------------------
 void Shader::SetInt(const std::string &name, int value) const
 { 
-    glUniform1i(glGetUniformLocation(m_ID, name.c_str()), value); 
+    glUniform1i(GetUniformLocation(name), value); 
 }
 // ------------------------------------------------------------------------
 void Shader::SetFloat(const std::string &name, float value) const
 { 
-    glUniform1f(glGetUniformLocation(m_ID, name.c_str()), value); 
+    glUniform1f(GetUniformLocation(name), value); 
 }
 //-------------------------------------------------------------------------
 void Shader::SetVec4(const std::string &name, const glm::vec4 &value) const
 {
-    glUniform4fv(glGetUniformLocation(m_ID, name.c_str()), 1, glm::value_ptr(value));
+    SetVec4(GetUniformLocation(name), value);
 }
 //-------------------------------------------------------------------------
 void Shader::SetMat4(const std::string &name, const glm::mat4 &value) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(m_ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+    SetMat4(GetUniformLocation(name), value);
+}
+//-------------------------------------------------------------------------
+void Shader::SetFloat(int location, float value) const
+{
+    glUniform1f(location, value);
+}
+//-------------------------------------------------------------------------
+void Shader::SetVec4(int location, const glm::vec4 &value) const
+{
+    glUniform4fv(location, 1, glm::value_ptr(value));
+}
+//-------------------------------------------------------------------------
+void Shader::SetMat4(int location, const glm::mat4 &value) const
+{
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+//-------------------------------------------------------------------------
+int Shader::GetUniformLocation(const std::string &name) const
+{
+    auto it = m_uniformLocations.find(name);
+    return it != m_uniformLocations.end() ? it->second : -1;
+}
+
+void Shader::CacheUniformLocations()
+{
+    // glGetUniformLocation by name on each draw is a string lookup in the driver
+    int nbUniforms = 0;
+    glGetProgramiv(m_ID, GL_ACTIVE_UNIFORMS, &nbUniforms);
+    char name[256];
+    for (int i = 0; i < nbUniforms; ++i)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_ID, static_cast<GLuint>(i), sizeof(name), &length, &size, &type, name);
+        m_uniformLocations[std::string(name, length)] = glGetUniformLocation(m_ID, name);
+    }
+    m_mvpLocation = GetUniformLocation("MVP");
+    m_colorLocation = GetUniformLocation("ourColor");
 }
 
 void Shader::CheckCompileErrors(unsigned int shader, const std::string& type) const
@@ -0,0 +1,322 @@
+#include <sharedMemory/shmTransport.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // WIN32
+
+#ifdef __linux__
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif // __linux__
+
+namespace
+{
+    // Spin a little before going to sleep, most answers come back in a few microseconds
+    constexpr unsigned int SPIN_COUNT = 256;
+
+    int64_t NowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    size_t AlignUp(size_t size, size_t alignment)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+}
+
+// --------------------------------------------------------
+// ShmDoorbell implementation
+// --------------------------------------------------------
+
+void ShmDoorbell::Initialize()
+{
+    sequence.store(0, std::memory_order_relaxed);
+    nbWaiters.store(0, std::memory_order_relaxed);
+}
+
+uint32_t ShmDoorbell::Prepare()
+{
+    // Must be visible before the last check of the waiter, see Ring
+    nbWaiters.fetch_add(1, std::memory_order_seq_cst);
+    return sequence.load(std::memory_order_seq_cst);
+}
+
+void ShmDoorbell::Cancel()
+{
+    nbWaiters.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void ShmDoorbell::Wait(uint32_t expectedSequence, int64_t timeoutUs)
+{
+#ifdef __linux__
+    timespec timeout;
+    timeout.tv_sec = static_cast<time_t>(timeoutUs / 1000000);
+    timeout.tv_nsec = static_cast<long>((timeoutUs % 1000000) * 1000);
+    // Not FUTEX_PRIVATE: the word is shared between processes
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sequence), FUTEX_WAIT, expectedSequence,
+        timeoutUs >= 0 ? &timeout : nullptr, nullptr, 0);
+#else
+    (void)timeoutUs;
+    if (sequence.load(std::memory_order_seq_cst) == expectedSequence)
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+#endif // __linux__
+    nbWaiters.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void ShmDoorbell::Ring()
+{
+    sequence.fetch_add(1, std::memory_order_seq_cst);
+#ifdef __linux__
+    // Avoid the syscall when nobody sleeps
+    if (nbWaiters.load(std::memory_order_seq_cst) > 0)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sequence), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif // __linux__
+}
+
+// --------------------------------------------------------
+// ShmTransport implementation
+// --------------------------------------------------------
+
+ShmTransport::ShmTransport(const std::string& name)
+    : m_name(name)
+{
+}
+
+ShmTransport::~ShmTransport()
+{
+    Close();
+}
+
+size_t ShmTransport::GetSegmentSize(uint32_t nbChannels)
+{
+    return AlignUp(sizeof(Header), alignof(ShmChannel)) + nbChannels * sizeof(ShmChannel);
+}
+
+uint32_t ShmTransport::GetNbChannels() const
+{
+    return m_header != nullptr ? m_header->nbChannels : 0;
+}
+
+ShmChannel& ShmTransport::GetChannel(uint32_t index)
+{
+    return m_channels[index];
+}
+
+#ifndef WIN32
+
+int ShmTransport::Map(size_t size, bool create)
+{
+    int fd = create ? shm_open(m_name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600) : shm_open(m_name.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+    {
+        std::cerr << "Failed to open shared memory " << m_name << ": " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+
+    if (create && ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        std::cerr << "Failed to resize shared memory " << m_name << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    if (!create)
+    {
+        struct stat status;
+        if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(Header))
+        {
+            std::cerr << "Shared memory " << m_name << " is not initialized" << std::endl;
+            close(fd);
+            return -1;
+        }
+        size = static_cast<size_t>(status.st_size);
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        std::cerr << "Failed to map shared memory " << m_name << std::endl;
+        return -1;
+    }
+
+    m_data = data;
+    m_size = size;
+    m_owner = create;
+    m_header = static_cast<Header*>(m_data);
+    m_channels = reinterpret_cast<ShmChannel*>(static_cast<char*>(m_data) + AlignUp(sizeof(Header), alignof(ShmChannel)));
+    return 0;
+}
+
+int ShmTransport::Create(uint32_t nbChannels)
+{
+    Close();
+    if (Map(GetSegmentSize(nbChannels), true) != 0)
+        return -1;
+
+    // The memory is zeroed by ftruncate, atomics are still initialized explicitly
+    m_header->version = VERSION;
+    m_header->nbChannels = nbChannels;
+    m_header->observationSize = static_cast<uint32_t>(CarState::FLAT_SIZE);
+    m_header->actionSize = static_cast<uint32_t>(CarAction::FLAT_SIZE);
+    m_header->observationsDoorbell.Initialize();
+    for (uint32_t i = 0; i < nbChannels; ++i)
+    {
+        m_channels[i].observations.Initialize();
+        m_channels[i].actions.Initialize();
+        m_channels[i].actionsDoorbell.Initialize();
+    }
+
+    // Written last, simulators check it to know the segment is ready
+    std::atomic_thread_fence(std::memory_order_release);
+    m_header->magic = MAGIC;
+    return 0;
+}
+
+int ShmTransport::Open()
+{
+    Close();
+    if (Map(0, false) != 0)
+        return -1;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_header->magic != MAGIC || m_header->version != VERSION ||
+        m_header->observationSize != CarState::FLAT_SIZE || m_header->actionSize != CarAction::FLAT_SIZE ||
+        m_size < GetSegmentSize(m_header->nbChannels))
+    {
+        std::cerr << "Shared memory " << m_name << " has an incompatible layout" << std::endl;
+        Close();
+        return -1;
+    }
+    return 0;
+}
+
+void ShmTransport::Close()
+{
+    if (m_data == nullptr)
+        return;
+
+    munmap(m_data, m_size);
+    if (m_owner)
+        shm_unlink(m_name.c_str());
+
+    m_data = nullptr;
+    m_size = 0;
+    m_header = nullptr;
+    m_channels = nullptr;
+    m_owner = false;
+}
+
+#else
+
+int ShmTransport::Map(size_t, bool)
+{
+    std::cerr << "Shared memory transport is not supported on Windows" << std::endl;
+    return -1;
+}
+
+int ShmTransport::Create(uint32_t) { return Map(0, true); }
+int ShmTransport::Open() { return Map(0, false); }
+void ShmTransport::Close() {}
+
+#endif // WIN32
+
+void ShmTransport::SendObservation(uint32_t channel, const ObservationRecord& record)
+{
+    while (!m_channels[channel].observations.TryPush(record))
+        std::this_thread::yield();
+    m_header->observationsDoorbell.Ring();
+}
+
+void ShmTransport::SendAction(uint32_t channel, const ActionRecord& record)
+{
+    ShmChannel& shmChannel = m_channels[channel];
+    while (!shmChannel.actions.TryPush(record))
+        std::this_thread::yield();
+    shmChannel.actionsDoorbell.Ring();
+}
+
+bool ShmTransport::ReceiveAction(uint32_t channel, ActionRecord& record, int64_t timeoutUs)
+{
+    ShmChannel& shmChannel = m_channels[channel];
+    for (unsigned int i = 0; i < SPIN_COUNT; ++i)
+    {
+        if (shmChannel.actions.TryPop(record))
+            return true;
+    }
+
+    int64_t deadline = NowUs() + timeoutUs;
+    while (true)
+    {
+        uint32_t sequence = shmChannel.actionsDoorbell.Prepare();
+        if (shmChannel.actions.TryPop(record))
+        {
+            shmChannel.actionsDoorbell.Cancel();
+            return true;
+        }
+
+        int64_t remaining = deadline - NowUs();
+        if (remaining <= 0)
+        {
+            shmChannel.actionsDoorbell.Cancel();
+            return false;
+        }
+        shmChannel.actionsDoorbell.Wait(sequence, remaining);
+    }
+}
+
+bool ShmTransport::ReceiveObservation(ObservationRecord& record, uint32_t& channel, int64_t timeoutUs)
+{
+    const uint32_t nbChannels = m_header->nbChannels;
+    auto tryPopAny = [this, nbChannels, &record, &channel]()
+    {
+        for (uint32_t i = 0; i < nbChannels; ++i)
+        {
+            uint32_t index = (m_nextChannel + i) % nbChannels;
+            if (m_channels[index].observations.TryPop(record))
+            {
+                channel = index;
+                m_nextChannel = index + 1;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (unsigned int i = 0; i < SPIN_COUNT; ++i)
+    {
+        if (tryPopAny())
+            return true;
+    }
+
+    ShmDoorbell& doorbell = m_header->observationsDoorbell;
+    int64_t deadline = NowUs() + timeoutUs;
+    while (true)
+    {
+        uint32_t sequence = doorbell.Prepare();
+        if (tryPopAny())
+        {
+            doorbell.Cancel();
+            return true;
+        }
+
+        int64_t remaining = deadline - NowUs();
+        if (remaining <= 0)
+        {
+            doorbell.Cancel();
+            return false;
+        }
+        doorbell.Wait(sequence, remaining);
+    }
+}
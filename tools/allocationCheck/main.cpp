@@ -0,0 +1,161 @@
+#include <metrics/allocationCounter.h>
+#include <metrics/frameTimings.h>
+#include <racingGame/car.h>
+#include <racingGame/controllers/cruiseCarController.h>
+#include <racingGame/gameManager.h>
+#include <racingGame/scenarios/scenario.h>
+#include <racingGame/scenarios/spawningStrategy.h>
+#include <utils/randomEngine.h>
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+// Runs headless frames once the simulation is warm and fails if
+// GameManager::Step touches the heap. Needs RACING_TRACK_ALLOCATIONS=ON.
+// Frames regenerating the track (a car left the playfield) and spawning the
+// cars again are reported but not counted: they are not steady state.
+
+namespace
+{
+    constexpr unsigned int SEED = 42;
+    // Offending frames printed in detail
+    constexpr unsigned int MAX_REPORTED_FRAMES = 10;
+
+    class CruiseScenario : public Scenario
+    {
+    public:
+        CruiseScenario(unsigned int nbCars) : m_nbCars(nbCars) {}
+
+        virtual void Update(GameManager& manager) override
+        {
+            if (m_nbSpawnedCars == 0)
+                SpawningStrategy::ResetInternalVariables();
+            while (m_nbSpawnedCars < m_nbCars)
+                SpawningStrategy::SpawnVehicle(manager, SpawningStrategy::Strategy_Spaced);
+        }
+
+        virtual void OnVehicleSpawned(Car* car) override
+        {
+            car->AttachController(&m_controller);
+            m_nbSpawnedCars++;
+        }
+
+        virtual void OnVehicleUnspawned(Car* car) override
+        {
+            car->DetachController();
+            m_nbSpawnedCars--;
+        }
+
+    private:
+        // Requires the state, so the observations are generated
+        CruiseCarController m_controller;
+        unsigned int m_nbCars;
+        unsigned int m_nbSpawnedCars = 0;
+    };
+
+    void PrintUsage()
+    {
+        std::cout << "Usage: AllocationCheck [--frames <n>] [--warmup <n>] [--cars <n>]" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int nbFrames = 10000;
+    unsigned int nbWarmupFrames = 300;
+    unsigned int nbCars = 10;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--frames") == 0 && hasValue)
+            nbFrames = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--warmup") == 0 && hasValue)
+            nbWarmupFrames = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--cars") == 0 && hasValue)
+            nbCars = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    if (!AllocationCounter::IsEnabled())
+    {
+        std::cerr << "Allocations are not tracked, configure with -DRACING_TRACK_ALLOCATIONS=ON" << std::endl;
+        return -1;
+    }
+
+    std::default_random_engine generator(SEED);
+    RandomEngine::ScopedGenerator scopedGenerator(generator);
+
+    GameConfig config;
+    config.enableRendering = false;
+    config.humanPlay = false;
+    config.attachCamera = false;
+    config.debugInfo = false;
+
+    CruiseScenario scenario(nbCars);
+    GameManager game(config, &scenario);
+    int errorCode = game.Setup();
+    if (errorCode != 0)
+        return errorCode;
+
+    const float dt = config.GetDt();
+    for (unsigned int i = 0; i < nbWarmupFrames; ++i)
+        game.Step(dt);
+
+    game.EnableFrameTimings(true);
+    std::array<AllocationCounts, STEP_PHASE_COUNT> phaseAllocations{};
+    unsigned int nbFailingFrames = 0;
+    unsigned int nbExcludedFrames = 0;
+    for (unsigned int frame = 0; frame < nbFrames; ++frame)
+    {
+        game.Step(dt);
+        const FrameTimings& timings = game.GetFrameTimings();
+        if (timings[StepPhase::Reset] > 0 || timings.nbSpawns > 0)
+        {
+            nbExcludedFrames++;
+            continue;
+        }
+
+        const AllocationCounts zero;
+        for (size_t phase = 0; phase < STEP_PHASE_COUNT; ++phase)
+            phaseAllocations[phase].AddDelta(zero, timings.phaseAllocations[phase]);
+
+        if (timings.totalAllocations.nbAllocations == 0)
+            continue;
+
+        if (++nbFailingFrames <= MAX_REPORTED_FRAMES)
+        {
+            std::cout << "Frame " << frame << ": " << timings.totalAllocations.nbAllocations << " allocations ("
+                      << timings.totalAllocations.bytes << " bytes)";
+            for (size_t phase = 0; phase < STEP_PHASE_COUNT; ++phase)
+            {
+                if (timings.phaseAllocations[phase].nbAllocations > 0)
+                    std::cout << ", " << GetStepPhaseName(static_cast<StepPhase>(phase)) << ": " << timings.phaseAllocations[phase].nbAllocations;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    std::cout << "Allocations per phase over " << nbFrames - nbExcludedFrames << " frames ("
+              << nbExcludedFrames << " frames with a reset or spawns excluded):" << std::endl;
+    for (size_t phase = 0; phase < STEP_PHASE_COUNT; ++phase)
+    {
+        std::cout << "    " << GetStepPhaseName(static_cast<StepPhase>(phase)) << ": " << phaseAllocations[phase].nbAllocations
+                  << " (" << phaseAllocations[phase].bytes << " bytes)" << std::endl;
+    }
+
+    if (nbFailingFrames > 0)
+    {
+        std::cout << "FAILED: " << nbFailingFrames << " frames allocated" << std::endl;
+        return 1;
+    }
+    std::cout << "OK: no allocation in GameManager::Step" << std::endl;
+    return 0;
+}
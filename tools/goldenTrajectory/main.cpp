@@ -0,0 +1,376 @@
+#include <racingGame/car.h>
+#include <racingGame/carAction.h>
+#include <racingGame/carState.h>
+#include <racingGame/racingEnvironment.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Regression harness for the dynamics. Runs a seeded race headless with
+// scripted actions (no randomness besides the seed) and records, for every
+// step and every car, the pose, the lap info, the reward and the observation.
+//   --record <file>   writes the golden
+//   --compare <file>  runs the race described in the golden again and reports
+//                     the first step, car and field out of tolerance (exit 1)
+// Record the golden before an optimization, compare after it. Tolerances are
+// absolute, relative for values above 1. Integer fields must match exactly.
+
+namespace
+{
+    constexpr unsigned int FORMAT_VERSION = 1;
+
+    enum FieldKind
+    {
+        Kind_Exact = 0,
+        Kind_State,
+        Kind_Observation,
+        Kind_Reward,
+        Kind_Count
+    };
+
+    struct Field
+    {
+        std::string name;
+        FieldKind kind;
+    };
+
+    // Names of the flat CarState, see carState.h
+    std::vector<std::string> GetObservationNames()
+    {
+        std::vector<std::string> names = { "distanceFromRoad", "velocityRoadRef.x", "velocityRoadRef.y", "angleWithRoad",
+            "wheelAngle0", "wheelAngle1", "wheelOmega0", "wheelOmega1", "wheelOmega2", "wheelOmega3", "carOmega", "driftAngle" };
+        for (size_t i = 0; i < SamplingIndexes::SAMPLING_INDEXES_SIZE; ++i)
+        {
+            names.push_back("pointsFurther" + std::to_string(i) + ".x");
+            names.push_back("pointsFurther" + std::to_string(i) + ".y");
+        }
+        return names;
+    }
+
+    // Values of a record, in this order
+    std::vector<Field> GetFields()
+    {
+        std::vector<Field> fields = {
+            { "episode", Kind_Exact }, { "done", Kind_Exact }, { "spawned", Kind_Exact },
+            { "position.x", Kind_State }, { "position.y", Kind_State }, { "angle", Kind_State },
+            { "velocity.x", Kind_State }, { "velocity.y", Kind_State },
+            { "trackIndex", Kind_Exact }, { "nbLaps", Kind_Exact },
+            { "lastLapTime", Kind_State }, { "bestLapTime", Kind_State },
+            { "reward", Kind_Reward }
+        };
+        for (const std::string& name : GetObservationNames())
+            fields.push_back({ "observation." + name, Kind_Observation });
+        return fields;
+    }
+
+    struct RunConfig
+    {
+        unsigned int seed = 0;
+        unsigned int nbCars = 4;
+        unsigned int nbSteps = 1000;
+    };
+
+    // One record per step and per car
+    struct Trajectory
+    {
+        RunConfig config;
+        std::vector<std::vector<double>> records;
+    };
+
+    // Deterministic actions exercising gas, braking, steering and drifts.
+    // Each car gets its own phase so they don't drive in lockstep.
+    CarAction GetScriptedAction(unsigned int step, unsigned int carIndex)
+    {
+        const float t = static_cast<float>(step);
+        const float phase = 1.3f * static_cast<float>(carIndex);
+        CarAction action;
+        action.gas = 0.6f + 0.4f * std::sin(0.05f * t + phase);
+        action.brake = (step + 17 * carIndex) % 97 < 6 ? 0.8f : 0.0f;
+        action.steer = 0.6f * std::sin(0.031f * t + phase) + 0.3f * std::sin(0.17f * t);
+        return action;
+    }
+
+    void AddRecords(const RacingEnvironment& environment, unsigned int episode, Trajectory& trajectory)
+    {
+        const float* observations = environment.GetObservations();
+        const float* rewards = environment.GetRewards();
+        for (unsigned int i = 0; i < environment.GetNbCars(); ++i)
+        {
+            std::vector<double> record = { static_cast<double>(episode), environment.IsDone() ? 1.0 : 0.0 };
+            const Car* car = environment.GetCar(i);
+            if (car != nullptr)
+            {
+                const glm::vec2 position = car->GetPosition();
+                const glm::vec2 velocity = car->GetVelocity();
+                const Car::LapInfo& lapInfo = car->GetLapInfo();
+                record.insert(record.end(), { 1.0, position.x, position.y, car->GetAngle(), velocity.x, velocity.y,
+                    static_cast<double>(car->GetCurrentTrackIndex()), static_cast<double>(lapInfo.nbLaps),
+                    lapInfo.lastLapTimeS, lapInfo.bestLapTimeS });
+            }
+            else
+            {
+                // Out of the playfield, the race was reset
+                record.push_back(0.0);
+                record.resize(record.size() + 9, 0.0);
+            }
+            record.push_back(rewards[i]);
+            // Only the CarState part
+            const float* observation = observations + i * environment.GetObservationSize();
+            record.insert(record.end(), observation, observation + RacingEnvironment::OBSERVATION_SIZE);
+            trajectory.records.push_back(std::move(record));
+        }
+    }
+
+    int Simulate(Trajectory& trajectory)
+    {
+        RacingEnvironment::Config config;
+        config.nbCars = trajectory.config.nbCars;
+        config.seed = trajectory.config.seed;
+        RacingEnvironment environment(config);
+        int errorCode = environment.Initialize();
+        if (errorCode != 0)
+            return errorCode;
+
+        unsigned int episode = 0;
+        environment.Reset();
+        std::vector<float> actions(config.nbCars * RacingEnvironment::ACTION_SIZE);
+        trajectory.records.clear();
+        trajectory.records.reserve(static_cast<size_t>(trajectory.config.nbSteps) * config.nbCars);
+        for (unsigned int step = 0; step < trajectory.config.nbSteps; ++step)
+        {
+            for (unsigned int i = 0; i < config.nbCars; ++i)
+                GetScriptedAction(step, i).Flatten(actions.data() + i * RacingEnvironment::ACTION_SIZE);
+
+            environment.Step(actions.data());
+            AddRecords(environment, episode, trajectory);
+            if (environment.IsDone())
+            {
+                environment.Reset();
+                episode++;
+            }
+        }
+        return 0;
+    }
+
+    int WriteGolden(const std::string& path, const Trajectory& trajectory)
+    {
+        std::ofstream file(path);
+        if (!file)
+        {
+            std::cerr << "Failed to open " << path << std::endl;
+            return -1;
+        }
+
+        file << "golden " << FORMAT_VERSION << " seed " << trajectory.config.seed << " cars " << trajectory.config.nbCars
+             << " steps " << trajectory.config.nbSteps << std::endl;
+        file << "fields";
+        for (const Field& field : GetFields())
+            file << " " << field.name;
+        file << std::endl;
+
+        // Enough digits to read back the same float
+        char buffer[32];
+        for (const std::vector<double>& record : trajectory.records)
+        {
+            for (size_t i = 0; i < record.size(); ++i)
+            {
+                snprintf(buffer, sizeof(buffer), "%.9g", record[i]);
+                file << (i == 0 ? "" : " ") << buffer;
+            }
+            file << "\n";
+        }
+        std::cout << trajectory.records.size() << " records written to " << path << std::endl;
+        return 0;
+    }
+
+    int ReadGolden(const std::string& path, Trajectory& trajectory)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cerr << "Failed to open " << path << std::endl;
+            return -1;
+        }
+
+        std::string magic;
+        std::string key;
+        unsigned int version = 0;
+        RunConfig& config = trajectory.config;
+        file >> magic >> version >> key >> config.seed >> key >> config.nbCars >> key >> config.nbSteps;
+        if (!file || magic != "golden" || version != FORMAT_VERSION)
+        {
+            std::cerr << path << " is not a golden trajectory of version " << FORMAT_VERSION << std::endl;
+            return -1;
+        }
+
+        // Fields must be the ones of this version of the tool
+        const std::vector<Field> fields = GetFields();
+        std::string line;
+        std::getline(file, line);
+        std::getline(file, line);
+        std::stringstream header(line);
+        header >> key;
+        for (const Field& field : fields)
+        {
+            std::string name;
+            header >> name;
+            if (name != field.name)
+            {
+                std::cerr << path << ": unexpected field " << name << ", expected " << field.name << std::endl;
+                return -1;
+            }
+        }
+
+        trajectory.records.clear();
+        while (std::getline(file, line))
+        {
+            std::vector<double> record;
+            record.reserve(fields.size());
+            const char* begin = line.c_str();
+            char* end = nullptr;
+            for (double value = std::strtod(begin, &end); end != begin; value = std::strtod(begin, &end))
+            {
+                // Every value was a float, read back the same one
+                record.push_back(static_cast<float>(value));
+                begin = end;
+            }
+            if (record.size() != fields.size())
+            {
+                std::cerr << path << ": record " << trajectory.records.size() << " has " << record.size() << " values, expected " << fields.size() << std::endl;
+                return -1;
+            }
+            trajectory.records.push_back(std::move(record));
+        }
+        return 0;
+    }
+
+    bool IsWithinTolerance(double golden, double value, double tolerance)
+    {
+        if (std::isnan(golden) || std::isnan(value))
+            return std::isnan(golden) && std::isnan(value);
+        return std::abs(value - golden) <= tolerance * std::max(1.0, std::abs(golden));
+    }
+
+    // Returns the number of records out of tolerance
+    size_t Compare(const Trajectory& golden, const Trajectory& trajectory, const double (&tolerances)[Kind_Count])
+    {
+        const std::vector<Field> fields = GetFields();
+        const unsigned int nbCars = golden.config.nbCars;
+        size_t nbDivergingRecords = 0;
+        double maxErrors[Kind_Count] = {};
+        for (size_t r = 0; r < golden.records.size() && r < trajectory.records.size(); ++r)
+        {
+            bool diverges = false;
+            for (size_t f = 0; f < fields.size(); ++f)
+            {
+                const double expected = golden.records[r][f];
+                const double value = trajectory.records[r][f];
+                const FieldKind kind = fields[f].kind;
+                if (!std::isnan(expected) && !std::isnan(value))
+                    maxErrors[kind] = std::max(maxErrors[kind], std::abs(value - expected));
+                if (IsWithinTolerance(expected, value, tolerances[kind]) || diverges)
+                    continue;
+
+                diverges = true;
+                if (nbDivergingRecords == 0)
+                {
+                    printf("First divergence at step %zu (episode %d), car %zu, field %s: golden %.9g, now %.9g (difference %.3g)\n",
+                        r / nbCars, static_cast<int>(golden.records[r][0]), r % nbCars, fields[f].name.c_str(),
+                        expected, value, value - expected);
+                }
+            }
+            if (diverges)
+                nbDivergingRecords++;
+        }
+
+        printf("Max absolute differences: state %.3g, observations %.3g, rewards %.3g\n",
+            maxErrors[Kind_State], maxErrors[Kind_Observation], maxErrors[Kind_Reward]);
+        return nbDivergingRecords;
+    }
+
+    void PrintUsage()
+    {
+        std::cout << "Usage: GoldenTrajectory (--record <file> [--seed <n>] [--cars <n>] [--steps <n>] | --compare <file>)" << std::endl
+                  << "                        [--state-tolerance <x>] [--observation-tolerance <x>] [--reward-tolerance <x>]" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* recordPath = nullptr;
+    const char* comparePath = nullptr;
+    Trajectory trajectory;
+    double tolerances[Kind_Count] = { 0.0, 1e-4, 1e-4, 1e-3 };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--record") == 0 && hasValue)
+            recordPath = argv[++i];
+        else if (strcmp(argv[i], "--compare") == 0 && hasValue)
+            comparePath = argv[++i];
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue)
+            trajectory.config.seed = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--cars") == 0 && hasValue)
+            trajectory.config.nbCars = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--steps") == 0 && hasValue)
+            trajectory.config.nbSteps = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--state-tolerance") == 0 && hasValue)
+            tolerances[Kind_State] = std::atof(argv[++i]);
+        else if (strcmp(argv[i], "--observation-tolerance") == 0 && hasValue)
+            tolerances[Kind_Observation] = std::atof(argv[++i]);
+        else if (strcmp(argv[i], "--reward-tolerance") == 0 && hasValue)
+            tolerances[Kind_Reward] = std::atof(argv[++i]);
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    if ((recordPath == nullptr) == (comparePath == nullptr) || trajectory.config.nbCars == 0)
+    {
+        PrintUsage();
+        return -1;
+    }
+
+    if (recordPath != nullptr)
+    {
+        int errorCode = Simulate(trajectory);
+        if (errorCode != 0)
+            return errorCode;
+        return WriteGolden(recordPath, trajectory);
+    }
+
+    Trajectory golden;
+    int errorCode = ReadGolden(comparePath, golden);
+    if (errorCode != 0)
+        return errorCode;
+
+    trajectory.config = golden.config;
+    errorCode = Simulate(trajectory);
+    if (errorCode != 0)
+        return errorCode;
+
+    if (trajectory.records.size() != golden.records.size())
+    {
+        std::cout << "FAILED: " << trajectory.records.size() << " records, the golden has " << golden.records.size() << std::endl;
+        return 1;
+    }
+
+    size_t nbDivergingRecords = Compare(golden, trajectory, tolerances);
+    if (nbDivergingRecords > 0)
+    {
+        std::cout << "FAILED: " << nbDivergingRecords << " of " << golden.records.size() << " records out of tolerance" << std::endl;
+        return 1;
+    }
+    std::cout << "OK: " << golden.records.size() << " records within tolerance" << std::endl;
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <racingGame/racingEnvironment.h>
+#include <metrics/trace.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Runs races without any display stack, with random actions. Mostly useful to
+// check a training node can simulate, and how fast.
+// With --pixels, the pixel observations are rendered too and the last frame of
+// each car is written as <prefix><car>.ppm.
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::cout << "Usage: HeadlessRunner [--cars <n>] [--steps <n>] [--seed <n>] [--trace <file.json>]" << std::endl
+                  << "                      [--pixels <prefix>] [--resolution <pixels>]" << std::endl;
+    }
+
+    int WritePpm(const std::string& path, const uint8_t* pixels, unsigned int width, unsigned int height)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Failed to open " << path << std::endl;
+            return -1;
+        }
+        file << "P6\n" << width << " " << height << "\n255\n";
+        file.write(reinterpret_cast<const char*>(pixels), static_cast<std::streamsize>(width) * height * SoftwareRasterizer::CHANNELS);
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    RacingEnvironment::Config config;
+    config.nbCars = 4;
+    unsigned int nbSteps = 10000;
+    const char* tracePath = nullptr;
+    const char* pixelsPrefix = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--cars") == 0 && hasValue)
+            config.nbCars = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--steps") == 0 && hasValue)
+            nbSteps = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue)
+            config.seed = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--trace") == 0 && hasValue)
+            tracePath = argv[++i];
+        else if (strcmp(argv[i], "--pixels") == 0 && hasValue)
+            pixelsPrefix = argv[++i];
+        else if (strcmp(argv[i], "--resolution") == 0 && hasValue)
+            config.rasterizer.width = config.rasterizer.height = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    config.pixelObservations = pixelsPrefix != nullptr;
+    RacingEnvironment environment(config);
+    int errorCode = environment.Initialize();
+    if (errorCode != 0)
+        return errorCode;
+    Trace::SetThreadName("Main");
+    Trace::Enable(tracePath != nullptr);
+    environment.Reset();
+
+    std::default_random_engine generator(config.seed);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> actions(config.nbCars * RacingEnvironment::ACTION_SIZE);
+    unsigned int nbEpisodes = 1;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int step = 0; step < nbSteps; ++step)
+    {
+        for (unsigned int i = 0; i < config.nbCars; ++i)
+        {
+            CarAction action;
+            action.gas = distribution(generator);
+            action.brake = 0.1f * distribution(generator);
+            action.steer = 2.0f * distribution(generator) - 1.0f;
+            action.Flatten(actions.data() + i * RacingEnvironment::ACTION_SIZE);
+        }
+
+        environment.Step(actions.data());
+        if (environment.IsDone())
+        {
+            environment.Reset();
+            ++nbEpisodes;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << nbSteps << " steps (" << nbSteps * config.frameSkip << " frames, " << nbEpisodes << " episodes) in "
+              << seconds << "s: " << nbSteps / seconds << " steps/s" << std::endl;
+
+    if (pixelsPrefix != nullptr)
+    {
+        const size_t frameSize = environment.GetPixelObservationSize();
+        for (unsigned int i = 0; i < config.nbCars; ++i)
+        {
+            errorCode = WritePpm(pixelsPrefix + std::to_string(i) + ".ppm", environment.GetPixels() + i * frameSize,
+                config.rasterizer.width, config.rasterizer.height);
+            if (errorCode != 0)
+                return errorCode;
+        }
+    }
+
+    if (tracePath != nullptr)
+        return Trace::WriteChromeTrace(tracePath);
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include <inference/inferenceServer.h>
+#include <inference/inferenceClient.h>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    InferenceServer* g_server = nullptr;
+
+    void OnSignal(int)
+    {
+        if (g_server != nullptr)
+            g_server->Stop();
+    }
+
+    void PrintUsage()
+    {
+        std::cout << "Usage: InferenceServer [--socket <path>] [--max-batch <n>] [--max-latency-us <us>]" << std::endl;
+        std::cout << "                       [--benchmark <nbClients> <nbRequestsPerClient>]" << std::endl;
+    }
+
+    // Run the server in a thread and hammer it with clients sending random states
+    int RunBenchmark(InferenceServer& server, const InferenceServer::Config& config, unsigned int nbClients, unsigned int nbRequests)
+    {
+        std::thread serverThread([&server]() { server.Run(); });
+
+        std::vector<std::vector<int64_t>> latencies(nbClients);
+        std::vector<std::thread> clients;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < nbClients; ++i)
+        {
+            clients.emplace_back([&config, &latencies, i, nbRequests]()
+            {
+                InferenceClient client(config.socketPath);
+                if (client.Connect() != 0)
+                    return;
+
+                std::default_random_engine generator(i);
+                std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+                std::vector<float> state(config.stateSize);
+                std::vector<float> action(config.actionSize);
+                latencies[i].reserve(nbRequests);
+                for (unsigned int j = 0; j < nbRequests; ++j)
+                {
+                    for (float& value : state)
+                        value = distribution(generator);
+
+                    auto tick = std::chrono::steady_clock::now();
+                    if (!client.Infer(state.data(), config.stateSize, action.data(), config.actionSize))
+                        return;
+                    auto duration = std::chrono::steady_clock::now() - tick;
+                    latencies[i].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+                }
+            });
+        }
+
+        for (std::thread& client : clients)
+            client.join();
+        auto totalTime = std::chrono::steady_clock::now() - start;
+
+        server.Stop();
+        serverThread.join();
+
+        std::vector<int64_t> allLatencies;
+        for (const auto& clientLatencies : latencies)
+            allLatencies.insert(allLatencies.end(), clientLatencies.begin(), clientLatencies.end());
+        if (allLatencies.empty())
+        {
+            std::cerr << "No request went through" << std::endl;
+            return -1;
+        }
+        std::sort(allLatencies.begin(), allLatencies.end());
+
+        auto percentile = [&allLatencies](double p)
+        {
+            size_t index = static_cast<size_t>(p * (allLatencies.size() - 1));
+            return allLatencies[index] / 1000.0;
+        };
+
+        const InferenceServer::Statistics& statistics = server.GetStatistics();
+        double seconds = std::chrono::duration<double>(totalTime).count();
+        std::cout << "Requests: " << allLatencies.size() << " in " << seconds << "s ("
+                  << allLatencies.size() / seconds << " req/s)" << std::endl;
+        std::cout << "Latency p50: " << percentile(0.5) << "us, p99: " << percentile(0.99)
+                  << "us, max: " << allLatencies.back() / 1000.0 << "us" << std::endl;
+        std::cout << "Batches: " << statistics.nbBatches << " (" << statistics.nbFullBatches << " full), mean size: "
+                  << static_cast<double>(statistics.nbRequests) / std::max<uint64_t>(statistics.nbBatches, 1)
+                  << ", biggest: " << statistics.biggestBatch << std::endl;
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    InferenceServer::Config config;
+    unsigned int benchmarkClients = 0;
+    unsigned int benchmarkRequests = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--socket") == 0 && hasValue)
+            config.socketPath = argv[++i];
+        else if (strcmp(argv[i], "--max-batch") == 0 && hasValue)
+            config.maxBatchSize = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--max-latency-us") == 0 && hasValue)
+            config.maxLatencyUs = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--benchmark") == 0 && i + 2 < argc)
+        {
+            benchmarkClients = static_cast<unsigned int>(std::atoi(argv[++i]));
+            benchmarkRequests = static_cast<unsigned int>(std::atoi(argv[++i]));
+        }
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    InferenceServer server(config);
+    int errorCode = server.Initialize();
+    if (errorCode != 0)
+        return errorCode;
+
+    if (benchmarkClients > 0)
+        return RunBenchmark(server, config, benchmarkClients, benchmarkRequests);
+
+    g_server = &server;
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+
+    std::cout << "Serving on " << config.socketPath << " (max batch " << config.maxBatchSize
+              << ", max latency " << config.maxLatencyUs << "us)" << std::endl;
+    errorCode = server.Run();
+
+    const InferenceServer::Statistics& statistics = server.GetStatistics();
+    std::cout << "Served " << statistics.nbRequests << " requests in " << statistics.nbBatches << " batches" << std::endl;
+    return errorCode;
+}
@@ -0,0 +1,59 @@
+#include <capi/racing.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Drives a few episodes through libracing with full gas, in plain C.
+ * Usage: RacingCApiExample [nbCars] [gridSize] */
+
+int main(int argc, char** argv)
+{
+    RacingConfig config;
+    racing_default_config(&config);
+    config.nbCars = argc > 1 ? (uint32_t)atoi(argv[1]) : 4;
+    /* Optional occupancy grid, appended to the observations */
+    config.gridSize = argc > 2 ? (uint32_t)atoi(argv[2]) : 0;
+
+    if (racing_get_api_version() != RACING_API_VERSION)
+    {
+        fprintf(stderr, "libracing API version mismatch\n");
+        return -1;
+    }
+
+    RacingEnv* env = racing_create(&config);
+    if (env == NULL)
+        return -1;
+
+    /* Wrapped once, the buffers never move */
+    RacingBuffer observations, actions, rewards;
+    racing_get_observations(env, &observations);
+    racing_get_actions(env, &actions);
+    racing_get_rewards(env, &rewards);
+    printf("observations: %lld x %lld, actions: %lld x %lld, rewards: %lld\n",
+        (long long)observations.shape[0], (long long)observations.shape[1],
+        (long long)actions.shape[0], (long long)actions.shape[1], (long long)rewards.shape[0]);
+
+    for (int episode = 0; episode < 3; ++episode)
+    {
+        racing_reset(env);
+        double totalReward = 0.0;
+        while (!racing_is_done(env))
+        {
+            for (int64_t car = 0; car < actions.shape[0]; ++car)
+            {
+                float* action = (float*)((char*)actions.data + car * actions.strides[0]);
+                action[0] = 1.0f;
+                action[1] = 0.0f;
+                action[2] = 0.0f;
+            }
+            racing_step(env);
+
+            for (int64_t car = 0; car < rewards.shape[0]; ++car)
+                totalReward += *(const float*)((const char*)rewards.data + car * rewards.strides[0]);
+        }
+        printf("Episode %d: %u steps, total reward %.2f\n", episode, racing_get_episode_step(env), totalReward);
+    }
+
+    racing_destroy(env);
+    return 0;
+}
@@ -0,0 +1,454 @@
+#include <debugManager/debugManager.h>
+#include <metrics/frameTimings.h>
+#include <racingGame/car.h>
+#include <racingGame/carAction.h>
+#include <racingGame/gameManager.h>
+#include <racingGame/pipelinedGameView.h>
+#include <racingGame/scenarios/spawningStrategy.h>
+#include <racingGame/scenarios/trainingScenario.h>
+#include <renderer/renderer.h>
+#include <renderer/rendererGameView.h>
+#include <shaders/shaderManager.h>
+#include <utils/randomEngine.h>
+
+#include <glad/glad.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Renders a race offscreen, in an EGL context without display (Mesa llvmpipe
+// on the CI nodes, LIBGL_ALWAYS_SOFTWARE=1 elsewhere), and checks the render
+// queue: each frame is drawn sorted and culled, then in submission order
+// without culling. The images must be identical, and sorting and culling must
+// not add any draw call, program or vertex array change.
+// Prints the GL work per frame and exits 1 on failure.
+// With --pipelined, the race is simulated on another thread and drawn through
+// snapshots (PipelinedGameView): only the last frame is drawn for sure, compare
+// its --ppm with the one of a normal run.
+
+namespace
+{
+    constexpr unsigned int SEED = 42;
+    constexpr unsigned int WIDTH = 800;
+    constexpr unsigned int HEIGHT = 600;
+    constexpr unsigned int NB_DEBUG_THREADS = 4;
+
+    void PrintUsage()
+    {
+        std::cout << "Usage: RenderCheck [--frames <n>] [--cars <n>] [--check-interval <frames>] [--ppm <file>] [--attach-camera] [--debug-lines] [--pipelined]" << std::endl;
+    }
+
+    // Current on this thread until the end of main
+    struct OffscreenContext
+    {
+        EGLDisplay display = EGL_NO_DISPLAY;
+        EGLContext context = EGL_NO_CONTEXT;
+        unsigned int framebuffer = 0;
+        unsigned int renderbuffers[2] = { 0, 0 };
+
+        int Create()
+        {
+            auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+            if (getPlatformDisplay != nullptr)
+                display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display == EGL_NO_DISPLAY)
+                display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+            if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+            {
+                std::cerr << "Failed to initialize EGL" << std::endl;
+                return -1;
+            }
+
+            const EGLint configAttributes[] = {
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                EGL_NONE
+            };
+            EGLConfig config;
+            EGLint nbConfigs = 0;
+            if (!eglChooseConfig(display, configAttributes, &config, 1, &nbConfigs) || nbConfigs == 0 || !eglBindAPI(EGL_OPENGL_API))
+            {
+                std::cerr << "No EGL config for desktop OpenGL" << std::endl;
+                return -1;
+            }
+
+            const EGLint contextAttributes[] = {
+                EGL_CONTEXT_MAJOR_VERSION, 3,
+                EGL_CONTEXT_MINOR_VERSION, 3,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                EGL_NONE
+            };
+            context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+            if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+            {
+                std::cerr << "Failed to create an OpenGL 3.3 core context (error 0x" << std::hex << eglGetError() << std::dec << ")" << std::endl;
+                return -1;
+            }
+            return 0;
+        }
+
+        // Needs the GL functions, after Renderer::InitializeWithContext
+        int CreateFramebuffer()
+        {
+            glGenFramebuffers(1, &framebuffer);
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            glGenRenderbuffers(2, renderbuffers);
+            glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, WIDTH, HEIGHT);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+            glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, WIDTH, HEIGHT);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, renderbuffers[1]);
+            if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            {
+                std::cerr << "Incomplete framebuffer" << std::endl;
+                return -1;
+            }
+            return 0;
+        }
+
+        void Destroy()
+        {
+            if (framebuffer != 0)
+            {
+                glDeleteRenderbuffers(2, renderbuffers);
+                glDeleteFramebuffers(1, &framebuffer);
+                framebuffer = 0;
+            }
+            if (display != EGL_NO_DISPLAY)
+            {
+                eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+                if (context != EGL_NO_CONTEXT)
+                    eglDestroyContext(display, context);
+                eglTerminate(display);
+                display = EGL_NO_DISPLAY;
+            }
+        }
+    };
+
+    struct FrameTotals
+    {
+        RenderStats stats;
+        int64_t renderNs = 0;
+
+        void Add(const RenderStats& frameStats, int64_t frameNs)
+        {
+            stats.nbItems += frameStats.nbItems;
+            stats.nbDrawCalls += frameStats.nbDrawCalls;
+            stats.nbProgramChanges += frameStats.nbProgramChanges;
+            stats.nbVertexArrayChanges += frameStats.nbVertexArrayChanges;
+            stats.nbSkippedChanges += frameStats.nbSkippedChanges;
+            stats.nbTransformUpdates += frameStats.nbTransformUpdates;
+            stats.nbCulled += frameStats.nbCulled;
+            renderNs += frameNs;
+        }
+
+        void Print(const char* name, unsigned int nbFrames) const
+        {
+            const double n = nbFrames > 0 ? nbFrames : 1;
+            std::cout << "    " << name << ": " << stats.nbItems / n << " items, " << stats.nbDrawCalls / n << " draw calls, "
+                      << stats.nbProgramChanges / n << " program changes, " << stats.nbVertexArrayChanges / n << " vertex array changes, "
+                      << stats.nbSkippedChanges / n << " skipped binds, " << stats.nbTransformUpdates / n << " transform updates, " << stats.nbCulled / n << " culled, " << renderNs / n / 1000.0 << "us" << std::endl;
+        }
+    };
+
+    // Each thread draws the line of a part of the cars
+    void DrawHeadings(const std::vector<const Car*>& cars, DebugManager::DebugId headingId)
+    {
+        std::thread threads[NB_DEBUG_THREADS];
+        for (unsigned int t = 0; t < NB_DEBUG_THREADS; ++t)
+        {
+            threads[t] = std::thread([&cars, headingId, t]()
+            {
+                for (size_t i = t; i < cars.size(); i += NB_DEBUG_THREADS)
+                {
+                    const glm::vec2 position = cars[i]->GetPosition();
+                    const float angle = cars[i]->GetAngle();
+                    const glm::vec2 heading(-std::sin(angle), std::cos(angle));
+                    DebugManager::GetInstance()->DrawLine(DebugManager::MakeKey(headingId, static_cast<uint32_t>(i)), position, position + 10.0f * heading, Colors::YELLOW);
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    std::vector<uint8_t> ReadPixels()
+    {
+        std::vector<uint8_t> pixels(static_cast<size_t>(WIDTH) * HEIGHT * 4);
+        glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        return pixels;
+    }
+
+    // Bottom-up RGBA rows from glReadPixels
+    int WritePpm(const char* path, const std::vector<uint8_t>& pixels)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Failed to open " << path << std::endl;
+            return -1;
+        }
+        file << "P6\n" << WIDTH << " " << HEIGHT << "\n255\n";
+        for (unsigned int y = HEIGHT; y-- > 0;)
+        {
+            for (unsigned int x = 0; x < WIDTH; ++x)
+                file.write(reinterpret_cast<const char*>(pixels.data() + (static_cast<size_t>(y) * WIDTH + x) * 4), 3);
+        }
+        return 0;
+    }
+
+    size_t CountDifferentPixels(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b)
+    {
+        size_t nbDifferent = 0;
+        for (size_t i = 0; i < a.size(); i += 4)
+            nbDifferent += memcmp(a.data() + i, b.data() + i, 4) != 0;
+        return nbDifferent;
+    }
+
+    // Simulates on a worker thread while this one draws the latest snapshot
+    int RunPipelined(const GameConfig& config, unsigned int nbFrames, unsigned int nbCars, bool debugLines, const char* ppmPath)
+    {
+        TrainingScenario scenario(nbCars, SpawningStrategy::Strategy_Formula1);
+        RendererGameView view;
+        PipelinedGameView pipeline(&view);
+        GameManager game(config, &scenario, &pipeline);
+        int errorCode = game.Setup();
+        if (errorCode != 0)
+            return errorCode;
+        scenario.Update(game);
+        CarAction action;
+        action.gas = 0.5f;
+        for (unsigned int i = 0; i < scenario.GetNbCars(); ++i)
+            scenario.GetController(i).SetAction(action);
+        DebugManager::GetInstance()->Enable(debugLines);
+        const DebugManager::DebugId headingId = DebugManager::Intern("heading");
+
+        // Per thread, the simulation must continue with the seeded ones of this thread
+        std::default_random_engine& generator = RandomEngine::GetInstance()->GetGenerator();
+        const SpawningStrategy::ThreadState spawningState = SpawningStrategy::GetThreadState();
+
+        std::atomic<bool> done = false;
+        const int64_t start = FrameTimings::NowNs();
+        std::thread simulation([&]()
+        {
+            RandomEngine::ScopedGenerator scopedGenerator(generator);
+            SpawningStrategy::SetThreadState(spawningState);
+            std::vector<const Car*> cars;
+            for (unsigned int frame = 0; frame < nbFrames; ++frame)
+            {
+                game.Step(config.GetDt());
+                if (debugLines)
+                {
+                    cars.clear();
+                    for (const auto& it : game.GetCars())
+                        cars.push_back(it.second);
+                    DrawHeadings(cars, headingId);
+                }
+                DebugManager::GetInstance()->Update(false);
+                pipeline.Render(game);
+            }
+            done = true;
+        });
+        while (!done)
+        {
+            if (!pipeline.RenderLatest())
+                std::this_thread::yield();
+        }
+        simulation.join();
+        const int64_t simulationNs = FrameTimings::NowNs() - start;
+        // The last snapshot, if it was published after the last draw
+        pipeline.RenderLatest();
+        glFinish();
+
+        std::cout << "Pipelined: " << pipeline.GetNbPublished() << " frames simulated in " << simulationNs / 1000000.0 << "ms, "
+                  << pipeline.GetNbRendered() << " drawn" << std::endl;
+        if (ppmPath != nullptr)
+            return WritePpm(ppmPath, ReadPixels());
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int nbFrames = 300;
+    unsigned int nbCars = 20;
+    unsigned int checkInterval = 50;
+    // Last frame, to look at what was checked
+    const char* ppmPath = nullptr;
+    // Follow the first car instead of the whole track in view, most of the scene is culled
+    bool attachCamera = false;
+    // A debug line per car, drawn from worker threads, all in one batch
+    bool debugLines = false;
+    bool pipelined = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--frames") == 0 && hasValue)
+            nbFrames = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--cars") == 0 && hasValue)
+            nbCars = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--check-interval") == 0 && hasValue)
+            checkInterval = std::max(static_cast<unsigned int>(std::atoi(argv[++i])), 1u);
+        else if (strcmp(argv[i], "--ppm") == 0 && hasValue)
+            ppmPath = argv[++i];
+        else if (strcmp(argv[i], "--attach-camera") == 0)
+            attachCamera = true;
+        else if (strcmp(argv[i], "--debug-lines") == 0)
+            debugLines = true;
+        else if (strcmp(argv[i], "--pipelined") == 0)
+            pipelined = true;
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    OffscreenContext offscreen;
+    int errorCode = offscreen.Create();
+    if (errorCode != 0)
+    {
+        offscreen.Destroy();
+        return errorCode;
+    }
+
+    Renderer::CreateInstance();
+    ShaderManager::CreateInstance();
+    Renderer* renderer = Renderer::GetInstance();
+    errorCode = renderer->InitializeWithContext(WIDTH, HEIGHT, reinterpret_cast<Renderer::LoadProc>(eglGetProcAddress));
+    if (errorCode == 0)
+        errorCode = offscreen.CreateFramebuffer();
+    if (errorCode != 0)
+    {
+        offscreen.Destroy();
+        return errorCode;
+    }
+    std::cout << "OpenGL " << glGetString(GL_VERSION) << ", " << glGetString(GL_RENDERER) << std::endl;
+
+    // Same track and cars on every run, frames can be compared across commits
+    std::default_random_engine generator(SEED);
+    RandomEngine::ScopedGenerator scopedGenerator(generator);
+
+    GameConfig config;
+    config.enableRendering = true;
+    config.windowWidth = WIDTH;
+    config.windowHeight = HEIGHT;
+    config.humanPlay = false;
+    config.attachCamera = attachCamera;
+    config.debugInfo = false;
+    config.adaptiveQuality = false;
+
+    if (pipelined)
+    {
+        renderer = nullptr;
+        errorCode = RunPipelined(config, nbFrames, nbCars, debugLines, ppmPath);
+        offscreen.Destroy();
+        return errorCode;
+    }
+
+    FrameTotals sorted;
+    FrameTotals unsorted;
+    unsigned int nbChecks = 0;
+    unsigned int nbFailures = 0;
+    {
+        TrainingScenario scenario(nbCars, SpawningStrategy::Strategy_Formula1);
+        // Takes the singletons, destroys them last
+        RendererGameView view;
+        GameManager game(config, &scenario, &view);
+        errorCode = game.Setup();
+        if (errorCode != 0)
+            nbFrames = 0;
+        else
+            scenario.Update(game);
+        DebugManager::GetInstance()->Enable(debugLines);
+        const DebugManager::DebugId headingId = DebugManager::Intern("heading");
+        std::vector<const Car*> cars;
+        CarAction action;
+        action.gas = 0.5f;
+        for (unsigned int i = 0; i < scenario.GetNbCars(); ++i)
+            scenario.GetController(i).SetAction(action);
+
+        const float dt = config.GetDt();
+        for (unsigned int frame = 0; frame < nbFrames; ++frame)
+        {
+            game.Step(dt);
+            if (debugLines)
+            {
+                cars.clear();
+                for (const auto& it : game.GetCars())
+                    cars.push_back(it.second);
+                DrawHeadings(cars, headingId);
+            }
+            DebugManager::GetInstance()->Update(false);
+
+            renderer->EnableSorting(true);
+            renderer->EnableCulling(true);
+            int64_t start = FrameTimings::NowNs();
+            view.Render(game);
+            glFinish();
+            sorted.Add(renderer->GetStats(), FrameTimings::NowNs() - start);
+            const RenderStats sortedStats = renderer->GetStats();
+            const bool check = frame % checkInterval == 0 || frame + 1 == nbFrames;
+            std::vector<uint8_t> sortedPixels;
+            if (check)
+                sortedPixels = ReadPixels();
+
+            // Same scene again, in submission order and with every car uploaded
+            renderer->EnableSorting(false);
+            renderer->EnableCulling(false);
+            start = FrameTimings::NowNs();
+            view.Render(game);
+            glFinish();
+            unsorted.Add(renderer->GetStats(), FrameTimings::NowNs() - start);
+            const RenderStats& unsortedStats = renderer->GetStats();
+
+            if (sortedStats.nbDrawCalls > unsortedStats.nbDrawCalls ||
+                sortedStats.nbProgramChanges > unsortedStats.nbProgramChanges ||
+                sortedStats.nbVertexArrayChanges > unsortedStats.nbVertexArrayChanges)
+            {
+                std::cout << "Frame " << frame << ": sorting and culling added draw calls or state changes" << std::endl;
+                nbFailures++;
+            }
+
+            if (!check)
+                continue;
+            nbChecks++;
+            const size_t nbDifferentPixels = CountDifferentPixels(sortedPixels, ReadPixels());
+            if (nbDifferentPixels > 0)
+            {
+                std::cout << "Frame " << frame << ": " << nbDifferentPixels << " pixels differ between the sorted and culled frame and the reference" << std::endl;
+                nbFailures++;
+            }
+            if (ppmPath != nullptr && frame + 1 == nbFrames)
+                WritePpm(ppmPath, sortedPixels);
+        }
+    }
+    renderer = nullptr;
+    offscreen.Destroy();
+    if (errorCode != 0)
+        return errorCode;
+
+    std::cout << "Per frame over " << nbFrames << " frames with " << nbCars << " cars:" << std::endl;
+    sorted.Print("sorted and culled", nbFrames);
+    unsorted.Print("submission order", nbFrames);
+
+    if (nbFailures > 0)
+    {
+        std::cout << "FAILED: " << nbFailures << " failed checks" << std::endl;
+        return 1;
+    }
+    std::cout << "OK: " << nbChecks << " frames identical with and without sorting and culling" << std::endl;
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <sharedMemory/shmTransport.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr int64_t TIMEOUT_US = 5000000;
+
+    int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void PrintUsage()
+    {
+        std::cout << "Usage: ShmTransportBenchmark [--simulators <n>] [--steps <n>] [--cars <n>]" << std::endl;
+    }
+
+    // Child process: fake simulator pushing one observation per car each step,
+    // then blocking until all the actions of that step came back
+    int RunSimulator(const std::string& name, uint32_t channel, unsigned int nbSteps, unsigned int nbCars)
+    {
+        ShmTransport transport(name);
+        if (transport.Open() != 0)
+            return -1;
+
+        std::vector<int64_t> latencies;
+        latencies.reserve(nbSteps);
+        ObservationRecord observation = {};
+        observation.envId = channel;
+        ActionRecord action;
+        for (unsigned int step = 0; step < nbSteps; ++step)
+        {
+            int64_t start = NowNs();
+            observation.step = step;
+            for (unsigned int car = 0; car < nbCars; ++car)
+            {
+                observation.carIndex = car;
+                std::fill(std::begin(observation.observation), std::end(observation.observation), static_cast<float>(step));
+                observation.timestampNs = NowNs();
+                transport.SendObservation(channel, observation);
+            }
+
+            for (unsigned int car = 0; car < nbCars; ++car)
+            {
+                if (!transport.ReceiveAction(channel, action, TIMEOUT_US) || action.step != step)
+                {
+                    std::cerr << "Simulator " << channel << " lost its trainer at step " << step << std::endl;
+                    return -1;
+                }
+            }
+            latencies.push_back(NowNs() - start);
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](double p)
+        {
+            return latencies[static_cast<size_t>(p * (latencies.size() - 1))] / 1000.0;
+        };
+        std::cout << "Simulator " << channel << " step round trip p50: " << percentile(0.5) << "us, p99: "
+                  << percentile(0.99) << "us, max: " << latencies.back() / 1000.0 << "us" << std::endl;
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int nbSimulators = 4;
+    unsigned int nbSteps = 10000;
+    unsigned int nbCars = 8;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--simulators") == 0 && hasValue)
+            nbSimulators = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--steps") == 0 && hasValue)
+            nbSteps = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (strcmp(argv[i], "--cars") == 0 && hasValue)
+            nbCars = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    if (nbSimulators == 0 || nbSteps == 0 || nbCars == 0 || nbCars > ShmChannel::CAPACITY)
+    {
+        PrintUsage();
+        return -1;
+    }
+
+    std::string name = "/racing_shm_bench_" + std::to_string(getpid());
+    ShmTransport transport(name);
+    if (transport.Create(nbSimulators) != 0)
+        return -1;
+
+    std::vector<pid_t> children;
+    for (uint32_t i = 0; i < nbSimulators; ++i)
+    {
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            std::cerr << "fork failed" << std::endl;
+            return -1;
+        }
+        if (pid == 0)
+            _exit(RunSimulator(name, i, nbSteps, nbCars) == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+        children.push_back(pid);
+    }
+
+    // Dummy trainer: answer every observation right away
+    const uint64_t nbRecords = static_cast<uint64_t>(nbSimulators) * nbSteps * nbCars;
+    uint64_t nbReceived = 0;
+    ObservationRecord observation;
+    ActionRecord action = {};
+    uint32_t channel = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (nbReceived < nbRecords)
+    {
+        if (!transport.ReceiveObservation(observation, channel, TIMEOUT_US))
+        {
+            std::cerr << "Trainer timed out after " << nbReceived << " observations" << std::endl;
+            break;
+        }
+        ++nbReceived;
+        action.step = observation.step;
+        action.envId = observation.envId;
+        action.carIndex = observation.carIndex;
+        action.action[0] = observation.observation[0];
+        action.timestampNs = observation.timestampNs;
+        transport.SendAction(channel, action);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int errorCode = nbReceived == nbRecords ? 0 : -1;
+    for (pid_t child : children)
+    {
+        int status = 0;
+        waitpid(child, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+            errorCode = -1;
+    }
+
+    std::cout << "Trainer: " << nbReceived << " observations in " << seconds << "s ("
+              << nbReceived / seconds << " obs/s, " << nbReceived * sizeof(ObservationRecord) / seconds / (1024.0 * 1024.0)
+              << " MiB/s)" << std::endl;
+    return errorCode;
+}